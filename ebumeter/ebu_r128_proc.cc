@@ -21,18 +21,23 @@
 
 #include <string.h>
 #include <math.h>
+#include "../jmeters/simd.h"
 #include "ebu_r128_proc.h"
 
 namespace LV2M {
 
-float Ebu_r128_hist::_bin_power [100] = { 0.0f };
-float Ebu_r128_proc::_chan_gain [5] = { 1.0f, 1.0f, 1.0f, 1.41f, 1.41f };
+float Ebu_r128_proc::_dflt_gain [5] = { 1.0f, 1.0f, 1.0f, 1.41f, 1.41f };
 
 
-Ebu_r128_hist::Ebu_r128_hist (void)
+Ebu_r128_hist::Ebu_r128_hist (int res, int nbin) :
+    _res (res),
+    _nbin (nbin),
+    _zero (70 * res)
 {
-    _histc = new int [751];
-    initstat ();
+    for (_nfen = 1; _nfen < nbin; _nfen <<= 1);
+    _histc = new int [_nbin];
+    _fcnt = new int [_nfen + 1];
+    _fpwr = new double [_nfen + 1];
     reset ();
 }
 
@@ -40,65 +45,82 @@ Ebu_r128_hist::Ebu_r128_hist (void)
 Ebu_r128_hist::~Ebu_r128_hist (void)
 {
     delete[] _histc;
+    delete[] _fcnt;
+    delete[] _fpwr;
 }
 
 
 void Ebu_r128_hist::reset (void)
 {
-    memset (_histc, 0, 751 * sizeof (float));
+    memset (_histc, 0, _nbin * sizeof (int));
+    memset (_fcnt, 0, (_nfen + 1) * sizeof (int));
+    memset (_fpwr, 0, (_nfen + 1) * sizeof (double));
+    _power = 0;
     _count = 0;
     _error = 0;
 }
 
 
-void Ebu_r128_hist::initstat (void)
-{
-    int i;
-
-    if (_bin_power [0]) return;
-    for (i = 0; i < 100; i++)
-    {
-	_bin_power [i] = powf (10.0f, i / 100.0f);
-    }
-}
-
-
 void Ebu_r128_hist::addpoint (float v)
 {
-    int k;
+    int    k;
+    double p;
 
-    k = (int) floorf (10 * v + 700.5f);
+    k = (int) floorf (_res * v + (_zero + 0.5f));
     if (k < 0) return;
-    if (k > 750)
+    if (k > _nbin - 1)
     {
-	k = 750;
+	k = _nbin - 1;
 	_error++;
     }
+    p = pow (10.0, (k - _zero) / (10.0 * _res));
     _histc [k]++;
     _count++;
+    _power += p;
+    // Tree node t holds bins [t - (t & -t), t).
+    for (int t = k + 1; t <= _nfen; t += t & -t)
+    {
+	_fcnt [t]++;
+	_fpwr [t] += p;
+    }
 }
 
 
-float Ebu_r128_hist::integrate (int i)
+int Ebu_r128_hist::count_below (int i) const
 {
-    int   j, k, n;
-    float s;
+    int n = 0;
+    for (int t = i; t > 0; t -= t & -t) n += _fcnt [t];
+    return n;
+}
 
-    j = i % 100;
-    n = 0;
-    s = 0;
-    while (i <= 750)
+
+double Ebu_r128_hist::power_below (int i) const
+{
+    double s = 0;
+    for (int t = i; t > 0; t -= t & -t) s += _fpwr [t];
+    return s;
+}
+
+
+int Ebu_r128_hist::search (float n) const
+{
+    // Descend the tree to the largest t with count_below (t) < n.
+    int t = 0;
+    for (int m = _nfen; m; m >>= 1)
     {
-	k = _histc [i++];
-	n += k;
-	s += k * _bin_power [j++];
-	if (j == 100)
+	if (t + m <= _nfen && _fcnt [t + m] < n)
 	{
-	    j = 0;
-	    s /= 10.0f;
+	    t += m;
+	    n -= _fcnt [t];
 	}
-    }	
-    return s / n;
+    }
+    return t;
+}
+
+
+float Ebu_r128_hist::integrate (int i)
+{
+    return (float)((_power - power_below (i)) / (_count - count_below (i)));
 }
 
 
@@ -112,13 +134,13 @@ void Ebu_r128_hist::calc_integ (float *vi, float *th)
         *vi = -200.0f;
 	return;
     }
-    s = integrate (0);
+    s = (float)(_power / _count);
 //  Original threshold was -8 dB below result of first integration
 //    if (th) *th = 10 * log10f (s) - 8.0f;
 //    k = (int)(floorf (100 * log10f (s) + 0.5f)) + 620;
 //  Threshold redefined to -10 dB below result of first integration
     if (th) *th = 10 * log10f (s) - 10.0f;
-    k = (int)(floorf (100 * log10f (s) + 0.5f)) + 600;
+    k = (int)(floorf (10 * _res * log10f (s) + 0.5f)) + _zero - 10 * _res;
     if (k < 0) k = 0;
     s = integrate (k);
     *vi = 10 * log10f (s);
@@ -127,7 +149,7 @@ void Ebu_r128_hist::calc_integ (float *vi, float *th)
 
 void Ebu_r128_hist::calc_range (float *v0, float *v1, float *th)
 {
-    int   i, j, k, n;
+    int   i, j, k, n, m;
     float a, b, s;
 
     if (_count < 20)
@@ -136,23 +158,27 @@ void Ebu_r128_hist::calc_range (float *v0, float *v1, float *th)
 	*v1 = -200.0f;
         return;
     }
-    s = integrate (0);
+    s = (float)(_power / _count);
     if (th) *th = 10 * log10f (s) - 20.0f;
-    k = (int)(floorf (100 * log10f (s) + 0.5)) + 500;
+    k = (int)(floorf (10 * _res * log10f (s) + 0.5)) + _zero - 20 * _res;
     if (k < 0) k = 0;
-    for (i = k, n = 0; i <= 750; i++) n += _histc [i]; 
+    m = count_below (k);
+    n = _count - m;
     a = 0.10f * n;
     b = 0.95f * n;
-    for (i =   k, s = 0; s < a; i++) s += _histc [i];
-    for (j = 750, s = n; s > b; j--) s -= _histc [j];
-    *v0 = (i - 701) / 10.0f;
-    *v1 = (j - 699) / 10.0f;
+    // First bins where the count from k reaches a, and exceeds b.
+    i = (a > 0) ? search (m + a) : k - 1;
+    j = (b < n) ? search (m + floorf (b) + 1) : _nbin;
+    *v0 = (i - _zero) / (float) _res;
+    *v1 = (j - _zero) / (float) _res;
 }
 
 
 
 
-Ebu_r128_proc::Ebu_r128_proc (void)
+Ebu_r128_proc::Ebu_r128_proc (void) :
+    _hist_MX (0),
+    _hist_SX (0)
 {
     reset ();
 }
@@ -160,12 +186,17 @@ Ebu_r128_proc::Ebu_r128_proc (void)
 
 Ebu_r128_proc::~Ebu_r128_proc (void)
 {
+    delete _hist_MX;
+    delete _hist_SX;
 }
 
 
 void Ebu_r128_proc::init (int nchan, float fsamp)
 {
+    if (nchan > MAXCH) nchan = MAXCH;
     _nchan = nchan;
+    for (int i = 0; i < MAXCH; i++) _chan_gain [i] = (i < 5) ? _dflt_gain [i] : 1.0f;
+    _isa = isa_level ();
     _fsamp = fsamp;
     _fragm = (int) fsamp / 20;
     detect_init (_fsamp);
@@ -173,6 +204,36 @@ void Ebu_r128_proc::init (int nchan, float fsamp)
 }
 
 
+void Ebu_r128_proc::set_layout (const Ebu_r128_chan *chan)
+{
+    for (int i = 0; i < _nchan; i++) _chan_gain [i] = chan_weight (chan + i);
+}
+
+
+void Ebu_r128_proc::integr_exact (bool on)
+{
+    // Allocates, not to be called while process() runs.
+    delete _hist_MX;
+    delete _hist_SX;
+    _hist_MX = on ? new Ebu_r128_hist (800, 65536) : 0;
+    _hist_SX = on ? new Ebu_r128_hist (800, 65536) : 0;
+    _integrated_x = -200.0f;
+    _range_min_x  = -200.0f;
+    _range_max_x  = -200.0f;
+}
+
+
+float Ebu_r128_proc::chan_weight (const Ebu_r128_chan *chan)
+{
+    // ITU-R BS.1770-4, table 3: +1.5 dB for surround channels
+    // near the horizontal plane, LFE is excluded.
+    if (chan->lfe) return 0.0f;
+    const float a = fabsf (chan->azim);
+    if (fabsf (chan->elev) < 30 && a >= 60 && a <= 120) return 1.41f;
+    return 1.0f;
+}
+
+
 void Ebu_r128_proc::reset (void)
 {
     _integr = false;
@@ -200,6 +261,11 @@ void Ebu_r128_proc::integr_reset (void)
     _range_min  = -200.0f;
     _range_max  = -200.0f;
     _range_thr  = -200.0f;
+    _integrated_x = -200.0f;
+    _range_min_x  = -200.0f;
+    _range_max_x  = -200.0f;
+    if (_hist_MX) _hist_MX->reset ();
+    if (_hist_SX) _hist_SX->reset ();
     _div1 = _div2 = 0;
 }
 
@@ -231,14 +297,24 @@ void Ebu_r128_proc::process (int nfram, float *input [])
 	        if (++_div1 == 2)
   	        {
 		    _hist_M.addpoint (_loudness_M);
+		    _hist_M.calc_integ (&_integrated, &_integ_thr);
+		    if (_hist_MX)
+		    {
+			_hist_MX->addpoint (_loudness_M);
+			_hist_MX->calc_integ (&_integrated_x, 0);
+		    }
 		    _div1 = 0;
 	        }
 	        if (++_div2 == 10)
 	        {
 		    _hist_S.addpoint (_loudness_S);
-		    _div2 = 0;
-		    _hist_M.calc_integ (&_integrated, &_integ_thr);
 		    _hist_S.calc_range (&_range_min, &_range_max, &_range_thr);
+		    if (_hist_SX)
+		    {
+			_hist_SX->addpoint (_loudness_S);
+			_hist_SX->calc_range (&_range_min_x, &_range_max_x, 0);
+		    }
+		    _div2 = 0;
 		}
 	    }
 	}
@@ -290,6 +366,30 @@ void Ebu_r128_proc::detect_init (float fsamp)
     _a0 *= r;
     _a1 *= r;
     _a2 *= r;
+
+    // Block state-space form for a single channel. With the state
+    // s = (z1, z2, z3, z4) before a group of four input samples u,
+    // the four outputs are y = Y * (s, u) and the state after the
+    // group is S * (s, u). Columns are found by running the filter
+    // in double precision on unit states and inputs.
+    for (int i = 0; i < 8; i++)
+    {
+	double z [4] = { 0, 0, 0, 0 };
+	double x, y;
+
+	if (i < 4) z [i] = 1;
+	for (int j = 0; j < 4; j++)
+	{
+	    x = ((i == 4 + j) ? 1 : 0) - _b1 * z [0] - _b2 * z [1];
+	    y = _a0 * x + _a1 * z [0] + _a2 * z [1] - _c3 * z [2] - _c4 * z [3];
+	    z [1] = z [0];
+	    z [0] = x;
+	    z [3] += z [2];
+	    z [2] += y;
+	    _ky [i][j] = (float) y;
+	}
+	for (int j = 0; j < 4; j++) _ks [i][j] = (float) z [j];
+    }
 }
 
 
@@ -301,39 +401,171 @@ void Ebu_r128_proc::detect_reset (void)
 
 float Ebu_r128_proc::detect_process (int nfram)
 {
-    int   i, j;
-    float si, sj;
-    float x, y, z1, z2, z3, z4;
-    float *p;
-    Ebu_r128_fst *S;
+    int   i;
+    float si;
 
-    si = 0;
-    for (i = 0, S = _fst; i < _nchan; i++, S++)
+    // A single channel is vectorized along time, otherwise
+    // channels are processed in parallel lanes.
+    if (_nchan == 1) return 2 * detect_block (_fst, _ipp [0], nfram);
+#ifdef ISA_X86
+    if (_nchan > 4 && _isa >= ISA_AVX2) return detect_avx2 (nfram);
+#endif
+
+    for (i = 0, si = 0; i < _nchan; i += 4)
     {
-	z1 = S->_z1;
-	z2 = S->_z2;
-	z3 = S->_z3;
-	z4 = S->_z4;
-	p = _ipp [i];
-	sj = 0;
-	for (j = 0; j < nfram; j++)
+	switch (_nchan - i)
 	{
-	    x = p [j] - _b1 * z1 - _b2 * z2 + 1e-15f;
-	    y = _a0 * x + _a1 * z1 + _a2 * z2 - _c3 * z3 - _c4 * z4;
-	    z2 = z1;
-	    z1 = x;
-	    z4 += z3;
-	    z3 += y;
-	    sj += y * y;
+	case 1:  detect_lanes <float> (i, nfram, si); break;
+	case 2:  detect_lanes <v2sf> (i, nfram, si); break;
+	default: detect_lanes <v4sf> (i, nfram, si); break;
 	}
-	if (_nchan == 1) si = 2 * sj;
-	else si += _chan_gain [i] * sj;
-	S->_z1 = !isfinite(z1) ? 0 : z1;
-	S->_z2 = !isfinite(z2) ? 0 : z2;
-	S->_z3 = !isfinite(z3) ? 0 : z3;
-	S->_z4 = !isfinite(z4) ? 0 : z4;
     }
     return si;
 }
 
+
+#ifdef ISA_X86
+// Groups of eight channels.
+float Ebu_r128_proc::detect_avx2 (int nfram)
+{
+    float si = 0;
+    for (int i = 0; i < _nchan; i += 8) detect_lanes <v8sf> (i, nfram, si);
+    return si;
+}
+#endif
+
+
+float Ebu_r128_proc::detect_block (Ebu_r128_fst *S, const float *p, int nfram)
+{
+    int   j;
+    float sj;
+    float x, y, z1, z2, z3, z4;
+    v4sf  s, u, v, acc;
+    v4sf  Y [8], T [8];
+
+    for (j = 0; j < 8; j++)
+    {
+	Y [j] = v4_load (_ky [j]);
+	T [j] = v4_load (_ks [j]);
+    }
+
+    s [0] = S->_z1;
+    s [1] = S->_z2;
+    s [2] = S->_z3;
+    s [3] = S->_z4;
+    acc = v4_set1 (0);
+    for (j = 0; j + 4 <= nfram; j += 4)
+    {
+	u = v4_load (p + j);
+	v = ((Y [0] * v4_set1 (s [0]) + Y [1] * v4_set1 (s [1]))
+	  +  (Y [2] * v4_set1 (s [2]) + Y [3] * v4_set1 (s [3])))
+	  + ((Y [4] * v4_set1 (u [0]) + Y [5] * v4_set1 (u [1]))
+	  +  (Y [6] * v4_set1 (u [2]) + Y [7] * v4_set1 (u [3])));
+	s = ((T [0] * v4_set1 (s [0]) + T [1] * v4_set1 (s [1]))
+	  +  (T [2] * v4_set1 (s [2]) + T [3] * v4_set1 (s [3])))
+	  + ((T [4] * v4_set1 (u [0]) + T [5] * v4_set1 (u [1]))
+	  +  (T [6] * v4_set1 (u [2]) + T [7] * v4_set1 (u [3])));
+	acc += v * v;
+    }
+    sj = v4_hsum (acc);
+
+    z1 = s [0];
+    z2 = s [1];
+    z3 = s [2];
+    z4 = s [3];
+    for (; j < nfram; j++)
+    {
+	x = p [j] - _b1 * z1 - _b2 * z2;
+	y = _a0 * x + _a1 * z1 + _a2 * z2 - _c3 * z3 - _c4 * z4;
+	z2 = z1;
+	z1 = x;
+	z4 += z3;
+	z3 += y;
+	sj += y * y;
+    }
+    S->_z1 = !isfinite(z1) ? 0 : z1;
+    S->_z2 = !isfinite(z2) ? 0 : z2;
+    S->_z3 = !isfinite(z3) ? 0 : z3;
+    S->_z4 = !isfinite(z4) ? 0 : z4;
+    return sj;
+}
+
+
+// Adds the weighted power of channels c to c + L::N - 1 to si.
+template <typename V>
+void Ebu_r128_proc::detect_lanes (int c, int nfram, float &si)
+{
+    typedef Lanes <V> L;
+    int   j, k, m;
+    float t1 [L::N], t2 [L::N], t3 [L::N], t4 [L::N];
+    float sg;
+    V     x, y, z1, z2, z3, z4, sj;
+
+    const V a0 = L::set1 (_a0);
+    const V a1 = L::set1 (_a1);
+    const V a2 = L::set1 (_a2);
+    const V b1 = L::set1 (_b1);
+    const V b2 = L::set1 (_b2);
+    const V c3 = L::set1 (_c3);
+    const V c4 = L::set1 (_c4);
+    const float *q [8];
+
+    // Unused lanes duplicate the first channel of the group.
+    m = (_nchan - c < L::N) ? _nchan - c : L::N;
+    for (k = 0; k < L::N; k++) q [k] = _ipp [(k < m) ? c + k : c];
+    for (k = 0; k < L::N; k++)
+    {
+	Ebu_r128_fst *S = _fst + ((k < m) ? c + k : c);
+	t1 [k] = S->_z1;
+	t2 [k] = S->_z2;
+	t3 [k] = S->_z3;
+	t4 [k] = S->_z4;
+    }
+    z1 = L::load (t1);
+    z2 = L::load (t2);
+    z3 = L::load (t3);
+    z4 = L::load (t4);
+    sj = L::set1 (0);
+    for (j = 0; j < nfram; j++)
+    {
+	x = L::gather (q, j) - b1 * z1 - b2 * z2;
+	y = a0 * x + a1 * z1 + a2 * z2 - c3 * z3 - c4 * z4;
+	z2 = z1;
+	z1 = x;
+	z4 += z3;
+	z3 += y;
+	sj += y * y;
+    }
+    L::store (t1, z1);
+    L::store (t2, z2);
+    L::store (t3, z3);
+    L::store (t4, z4);
+
+    for (k = 0; k < m; k++)
+    {
+	Ebu_r128_fst *S = _fst + c + k;
+	S->_z1 = !isfinite(t1 [k]) ? 0 : t1 [k];
+	S->_z2 = !isfinite(t2 [k]) ? 0 : t2 [k];
+	S->_z3 = !isfinite(t3 [k]) ? 0 : t3 [k];
+	S->_z4 = !isfinite(t4 [k]) ? 0 : t4 [k];
+    }
+    // Summed per group of four channels, in the same order as
+    // with four lanes.
+    L::store (t1, sj);
+    for (j = 0; j < m; j += 4)
+    {
+	for (k = j, sg = 0; k < j + 4 && k < m; k++) sg += _chan_gain [c + k] * t1 [k];
+	si += sg;
+    }
+}
+
+
+// Eight lane kernel, compiled for AVX2, see cpuisa.h.
+#if defined (ISA_X86) && !defined (__clang__)
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+template void Ebu_r128_proc::detect_lanes <v8sf> (int c, int nfram, float &si);
+#pragma GCC pop_options
+#endif
+
 }
@@ -23,10 +23,24 @@
 #define __EBU_R128_PROC_H
 
 
-#define MAXCH 5
+#include "../jmeters/cpuisa.h"
+
+#define MAXCH 24
 
 namespace LV2M {
 
+// Loudspeaker position of a channel, as in ITU-R BS.2051. Angles are
+// in degrees, positive azimuth is to the left, positive elevation up.
+
+struct Ebu_r128_chan
+{
+    const char *label;
+    float       azim;
+    float       elev;
+    bool        lfe;
+};
+
+
 class Ebu_r128_fst
 {
 private:
@@ -39,27 +53,47 @@ private:
 };
 
 
+// Histogram of loudness values, in bins of 1/res LU from -70 LUFS.
+// The default of 0.1 LU bins, 0 LU at bin 700, is used for display
+// and the live readings. Counts and powers are also kept in binary
+// indexed (Fenwick) trees, so the sums above a gate and the percentiles
+// used by calc_integ () and calc_range () take O(log bins) instead of a
+// scan of all bins.
+//
+// With 65536 bins of 1/800 LU every gating block is stored as a 16 bit
+// log-encoded code. Memory is fixed at about 1 MB, independent of the
+// program length, and the quantization error of the gated results is
+// below 0.001 LU.
+
 class Ebu_r128_hist
 {
 private:
 
-    Ebu_r128_hist (void);
+    Ebu_r128_hist (int res = 10, int nbin = 751);
     ~Ebu_r128_hist (void);
 
     friend class Ebu_r128_proc;
 
-    void  reset (void);
-    void  initstat (void);
-    void  addpoint (float v);
-    float integrate (int ind);
-    void  calc_integ (float *vi, float *th);
-    void  calc_range (float *v0, float *v1, float *th);
-
-    int  *_histc;
-    int   _count;
-    int   _error;
-
-    static float _bin_power [100];
+    void   reset (void);
+    void   addpoint (float v);
+    float  integrate (int ind);
+    void   calc_integ (float *vi, float *th);
+    void   calc_range (float *v0, float *v1, float *th);
+
+    int    count_below (int ind) const;  // points in bins [0, ind)
+    double power_below (int ind) const;  // their power sum
+    int    search (float n) const;       // first bin with count of bins [0, bin] >= n
+
+    int     _res;         // bins per LU
+    int     _nbin;        // number of bins
+    int     _nfen;        // tree size, power of 2 >= _nbin
+    int     _zero;        // bin of 0 LUFS
+    int    *_histc;
+    int    *_fcnt;        // Fenwick tree of counts [_nfen + 1]
+    double *_fpwr;        // Fenwick tree of powers [_nfen + 1]
+    double  _power;       // total power
+    int     _count;
+    int     _error;
 };
 
 
@@ -72,11 +106,14 @@ public:
     ~Ebu_r128_proc (void);
 
     void  init (int nchan, float fsamp);
+    void  set_layout (const Ebu_r128_chan *chan);
+    void  set_chan_gain (int c, float g) { if (c >= 0 && c < _nchan) _chan_gain [c] = g; }
     void  reset (void);
     void  process (int nfram, float *input []);
     void  integr_reset (void);
     void  integr_pause (void) { _integr = false; }
     void  integr_start (void) { _integr = true; }
+    void  integr_exact (bool on);
 
     float loudness_M (void) const { return _loudness_M; }
     float maxloudn_M (void) const { return _maxloudn_M; }
@@ -87,6 +124,13 @@ public:
     float range_min (void) const { return _range_min; }
     float range_max (void) const { return _range_max; }
     float range_thr (void) const { return _range_thr; }
+    bool  exact (void) const { return _hist_MX != 0; }
+    float integrated_exact (void) const { return _integrated_x; }
+    float range_min_exact (void) const { return _range_min_x; }
+    float range_max_exact (void) const { return _range_max_x; }
+    float chan_gain (int c) const { return _chan_gain [c]; }
+
+    static float chan_weight (const Ebu_r128_chan *chan);
 
     const int *histogram_M (void) const { return _hist_M._histc; }
     const int *histogram_S (void) const { return _hist_S._histc; }
@@ -99,17 +143,23 @@ private:
     void  detect_init (float fsamp);
     void  detect_reset (void);
     float detect_process (int nfram);
+    float detect_block (Ebu_r128_fst *S, const float *p, int nfram);
+    template <typename V> ISA_INLINE void detect_lanes (int c, int nfram, float &si);
+#ifdef ISA_X86
+    ISA_AVX2_TARGET float detect_avx2 (int nfram);
+#endif
 
     bool              _integr;       // Integration on/off.
-    int               _nchan;        // Number of channels, 2 or 5.
+    int               _nchan;        // Number of channels, 1 to MAXCH.
+    int               _isa;          // Kernel variant, see cpuisa.h.
     float             _fsamp;        // Sample rate.
     int               _fragm;        // Fragmenst size, 1/20 second.
     int               _frcnt;        // Number of samples remaining in current fragment.
     float             _frpwr;        // Power accumulated for current fragment.
     float             _power [64];   // Array of fragment powers.
     int               _wrind;        // Write index into _frpwr 
-    int               _div1;         // M period counter, 200 ms;
-    int               _div2;         // S period counter, 1s;
+    int               _div1;         // M period counter, 100 ms;
+    int               _div2;         // S period counter, 500 ms;
     float             _loudness_M;
     float             _maxloudn_M;
     float             _loudness_S;
@@ -119,18 +169,26 @@ private:
     float             _range_min;
     float             _range_max;
     float             _range_thr;
+    float             _integrated_x; // Results of the exact histograms.
+    float             _range_min_x;
+    float             _range_max_x;
     
     // Filter coefficients and states.
     float             _a0, _a1, _a2;
     float             _b1, _b2;
     float             _c3, _c4;
-    float            *_ipp [MAXCH];
+    float             _ky [8][4];    // Block form, outputs of 4 samples.
+    float             _ks [8][4];    // Block form, state after 4 samples.
+    float            *_ipp [MAXCH + 7]; // padded to full lane groups
     Ebu_r128_fst      _fst [MAXCH];
     Ebu_r128_hist     _hist_M;
     Ebu_r128_hist     _hist_S;
+    Ebu_r128_hist    *_hist_MX;      // Exact mode, 16 bit codes, or null.
+    Ebu_r128_hist    *_hist_SX;
+    float             _chan_gain [MAXCH]; // Channel weights.
 
-    // Default channel gains.
-    static float      _chan_gain [5];
+    // Default channel gains, L R C Ls Rs.
+    static float      _dflt_gain [5];
 };
 
 };
@@ -23,6 +23,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "../jmeters/fastmath.h"
+
 #define RTK_URI "http://gareus.org/oss/lv2/meters#"
 #define RTK_GUI "dpmui"
 #define MTR_URI RTK_URI
@@ -1216,7 +1218,7 @@ static void handle_spectrum_connections(SAUI* ui, uint32_t port_index, float v)
 
 static void handle_meter_connections(SAUI* ui, uint32_t port_index, float v) {
 	if (v <= -500) return;
-	v = v > .00001f ? 20.0 * log10f(v) : -100.0;
+	v = v > .00001f ? LV2M::fast_coeff_to_db(v) : -100.0;
 	if (port_index == 3) {
 		invalidate_meter(ui, 0, v, ui->peak_val[0]);
 	}
@@ -33,6 +33,7 @@
 
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
 #include "src/uris.h"
+#include "../jmeters/fastmath.h"
 
 #ifndef MAX
 #define MAX(A,B) ( (A) > (B) ? (A) : (B) )
@@ -118,6 +119,7 @@ typedef struct {
 	RobTkCBtn* cbx_transport;
 	RobTkCBtn* cbx_autoreset;
 	RobTkCBtn* cbx_truepeak;
+	RobTkCBtn* cbx_exact;
 
 	RobTkRBtn* cbx_radar;
 	RobTkRBtn* cbx_histogram;
@@ -152,6 +154,7 @@ typedef struct {
 
 	/* current data */
 	float lm, mm, ls, ms, il, rn, rx, it, tp;
+	int tpx; // true-peak oversampling factor
 
 	float *radarS;
 	float *radarM;
@@ -177,31 +180,6 @@ typedef struct {
 } EBUrUI;
 
 
-/******************************************************************************
- * fast math helpers
- */
-
-static inline float fast_log2 (float val)
-{
-	union {float f; int i;} t;
-	t.f = val;
-	int * const    exp_ptr =  &t.i;
-	int            x = *exp_ptr;
-	const int      log_2 = ((x >> 23) & 255) - 128;
-	x &= ~(255 << 23);
-	x += 127 << 23;
-	*exp_ptr = x;
-
-	val = ((-1.0f/3) * t.f + 2) * t.f - 2.0f/3;
-
-	return (val + log_2);
-}
-
-static inline float fast_log10 (const float val)
-{
-	return fast_log2(val) * 0.301029996f;
-}
-
 /******************************************************************************
  * meter colors
  */
@@ -622,7 +600,7 @@ static void render_radar (EBUrUI* ui) {
 
 			for (int ang = amin; ang < amax; ++ang) {
 				if (rdr[ang] <= 0) continue;
-				const float rad = (float) RADIUS * (1.0 + fast_log10(rdr[ang] / (float) len));
+				const float rad = (float) RADIUS * (1.0 + LV2M::fast_log10(rdr[ang] / (float) len));
 				if (rad < 5) continue;
 
 				cairo_move_to(cr, 0, 0);
@@ -920,7 +898,8 @@ static bool expose_event(RobWidget* handle, cairo_t* cr, cairo_rectangle_t *ev)
 		CairoSetSouerceRGBA(c_g20);
 		rounded_rectangle (cr, COORD_TP_X+10, COORD_ML_Y+25, 40, 30, 10);
 		cairo_fill (cr);
-		write_text(cr, "True", FONT(FONT_S08), COORD_TP_X+30, COORD_ML_Y+25+15, 0, 8, c_wht);
+		sprintf(buf, "True %dx", ui->tpx);
+		write_text(cr, buf, FONT(FONT_S08), COORD_TP_X+30, COORD_ML_Y+25+15, 0, 8, c_wht);
 	}
 
 	if (dbtp && rect_intersect_a(ev, COORD_TP_X, COORD_ML_Y, 75, 38)) {
@@ -1345,6 +1324,7 @@ static bool cbx_lufs(RobWidget *w, void* handle) {
 	v |= robtk_rbtn_get_active(ui->cbx_hist_short) ? 8 : 0;
 	v |= robtk_rbtn_get_active(ui->cbx_histogram) ? 16 : 0;
 	v |= robtk_cbtn_get_active(ui->cbx_truepeak) ? 64 : 0;
+	v |= robtk_cbtn_get_active(ui->cbx_exact) ? 128 : 0;
 	forge_message_kv(ui, ui->uris.mtr_meters_cfg, CTL_UISETTINGS, (float)v);
 	ui->redraw_labels = TRUE;
 	invalidate_changed(ui, -1);
@@ -1398,6 +1378,7 @@ instantiate(
 	ui->write      = write_function;
 	ui->controller = controller;
 	ui->fastradar = -1;
+	ui->tpx = 4;
 
 	*widget = NULL;
 
@@ -1430,7 +1411,7 @@ instantiate(
 	ui->btn_start = robtk_cbtn_new("Integrate", GBT_LED_OFF, false);
 	ui->btn_reset = robtk_pbtn_new("Reset");
 
-	ui->cbx_box = rob_table_new(/*rows*/6, /*cols*/ 5, FALSE);
+	ui->cbx_box = rob_table_new(/*rows*/7, /*cols*/ 5, FALSE);
 	ui->cbx_lu         = robtk_rbtn_new("LU", NULL);
 	ui->cbx_lufs       = robtk_rbtn_new("LUFS", robtk_rbtn_group(ui->cbx_lu));
 
@@ -1454,6 +1435,7 @@ instantiate(
 #else
 	ui->cbx_truepeak   = robtk_cbtn_new("Compute True-Peak", GBT_LED_LEFT, true);
 #endif
+	ui->cbx_exact      = robtk_cbtn_new("Exact Integration", GBT_LED_LEFT, true);
 
 	ui->sep_h0         = robtk_sep_new(TRUE);
 	ui->sep_h1         = robtk_sep_new(TRUE);
@@ -1493,8 +1475,10 @@ instantiate(
 	row++;
 	rob_table_attach(ui->cbx_box, GRB_W(ui->cbx_ring_mom)  , 0, 1, row, row+1, 0, 0, RTK_EXANDF, RTK_SHRINK);
 	rob_table_attach(ui->cbx_box, GRB_W(ui->cbx_ring_short), 1, 2, row, row+1, 0, 0, RTK_EXANDF, RTK_SHRINK);
+	row++;
+	rob_table_attach(ui->cbx_box, GBT_W(ui->cbx_exact)     , 0, 2, row, row+1, 0, 0, RTK_EXANDF, RTK_SHRINK);
 
-	rob_table_attach_defaults(ui->cbx_box, robtk_sep_widget(ui->sep_v0), 2, 3, 0, 6);
+	rob_table_attach_defaults(ui->cbx_box, robtk_sep_widget(ui->sep_v0), 2, 3, 0, 7);
 
 	row = 0; // right side
 	rob_table_attach(ui->cbx_box, GRB_W(ui->cbx_histogram) , 3, 4, row, row+1, 0, 0, RTK_EXANDF, RTK_SHRINK);
@@ -1533,6 +1517,7 @@ instantiate(
 	robtk_rbtn_set_callback(ui->cbx_ring_short, cbx_lufs, ui);
 	robtk_rbtn_set_callback(ui->cbx_histogram, cbx_lufs, ui);
 	robtk_cbtn_set_callback(ui->cbx_truepeak, cbx_lufs, ui);
+	robtk_cbtn_set_callback(ui->cbx_exact, cbx_lufs, ui);
 
 	robtk_cbtn_set_callback(ui->cbx_transport, cbx_transport, ui);
 	robtk_cbtn_set_callback(ui->cbx_autoreset, cbx_autoreset, ui);
@@ -1606,6 +1591,7 @@ cleanup(LV2UI_Handle handle)
 	robtk_cbtn_destroy(ui->cbx_transport);
 	robtk_cbtn_destroy(ui->cbx_autoreset);
 	robtk_cbtn_destroy(ui->cbx_truepeak);
+	robtk_cbtn_destroy(ui->cbx_exact);
 	robtk_spin_destroy(ui->spn_radartime);
 	robtk_cbtn_destroy(ui->btn_start);
 	robtk_pbtn_destroy(ui->btn_reset);
@@ -1665,6 +1651,7 @@ static bool parse_ebulevels(EBUrUI* ui, const LV2_Atom_Object* obj) {
 	LV2_Atom *ii = NULL;
 	LV2_Atom *it = NULL;
 	LV2_Atom *tp = NULL;
+	LV2_Atom *tx = NULL;
 
 	lv2_atom_object_get(obj,
 			uris->ebu_loudnessM, &lm,
@@ -1675,6 +1662,7 @@ static bool parse_ebulevels(EBUrUI* ui, const LV2_Atom_Object* obj) {
 			uris->ebu_range_min, &rn,
 			uris->ebu_range_max, &rx,
 			uris->mtr_truepeak, &tp,
+			uris->mtr_tpfactor, &tx,
 			uris->ebu_integrating, &ii,
 			uris->ebu_integr_time, &it,
 			NULL
@@ -1698,6 +1686,11 @@ static bool parse_ebulevels(EBUrUI* ui, const LV2_Atom_Object* obj) {
 	PARSE_CHANGED_FLOAT(rx, ui->rx)
 	PARSE_CHANGED_FLOAT(tp, ui->tp)
 
+	if (tx && tx->type == uris->atom_Int && ((LV2_Atom_Int*)tx)->body != ui->tpx) {
+		ui->tpx = ((LV2_Atom_Int*)tx)->body;
+		queue_tiny_area(ui->m0, COORD_TP_X+10, COORD_ML_Y+25, 40, 30);
+	}
+
 	if (ii && ii->type == uris->atom_Bool) {
 		bool ix = ((LV2_Atom_Bool*)ii)->body;
 	  bool bx = robtk_cbtn_get_active(ui->btn_start);
@@ -1874,6 +1867,7 @@ port_event(LV2UI_Handle handle,
 						robtk_rbtn_set_active(ui->cbx_radar, true);
 					}
 					robtk_cbtn_set_active(ui->cbx_truepeak, (vv & 64) ? true: false);
+					robtk_cbtn_set_active(ui->cbx_exact, (vv & 128) ? true: false);
 					ui->disable_signals = false;
 				}
 			} else if (obj->body.otype == uris->rdr_radarpoint) {
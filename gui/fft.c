@@ -21,6 +21,8 @@
 #include <stdio.h>
 #include <sys/types.h>
 
+#include "../jmeters/fastmath.h"
+
 #ifndef MIN
 #define MIN(A, B) ((A) < (B) ? (A) : (B))
 #endif
@@ -399,43 +401,18 @@ fftx_bins (struct FFTAnalysis* ft)
 
 FFTX_FN_PREFIX
 inline float
-fast_log2 (float val)
-{
-	union {
-		float f;
-		int   i;
-	} t;
-	t.f                = val;
-	int* const exp_ptr = &t.i;
-	int        x       = *exp_ptr;
-	const int  log_2   = ((x >> 23) & 255) - 128;
-	x &= ~(255 << 23);
-	x += 127 << 23;
-	*exp_ptr = x;
-	val      = ((-1.0f / 3) * t.f + 2) * t.f - 2.0f / 3;
-	return (val + log_2);
-}
-
-FFTX_FN_PREFIX
-inline float
-fast_log (const float val)
-{
-	return (fast_log2 (val) * 0.69314718f);
-}
-
-FFTX_FN_PREFIX
-inline float
-fast_log10 (const float val)
+fftx_power_to_dB (float a)
 {
-	return fast_log2 (val) / 3.312500f;
+	/* 10 * log10 of the squared signal -- no sqrt(power[]) */
+	return a > 1e-12 ? LV2M::fast_power_to_db (a) : -INFINITY;
 }
 
+/* fftx_power_to_dB() of n values at once, dst may equal src */
 FFTX_FN_PREFIX
-inline float
-fftx_power_to_dB (float a)
+void
+fftx_power_to_dB_array (float* dst, const float* src, uint32_t n)
 {
-	/* 10 instead of 20 because of squared signal -- no sqrt(powerp[]) */
-	return a > 1e-12 ? 10.0 * fast_log10 (a) : -INFINITY;
+	LV2M::fast_power_to_db (dst, src, n, -120.f, -INFINITY);
 }
 
 FFTX_FN_PREFIX
@@ -33,6 +33,8 @@ typedef void Stcorrdsp;
 
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
 #include "../zita-resampler/resampler.h"
+#include "../jmeters/denormal.h"
+#include "../jmeters/fastmath.h"
 #include "../src/goniometer.h"
 
 #define GED_W(PTR) robtk_dial_widget(PTR)
@@ -57,8 +59,8 @@ typedef void Stcorrdsp;
 #define MAX_CAIRO_PATH 256
 #define PC_BLOCKSIZE (PC_HEIGHT - PC_BLOCK - 2)
 
-#define GAINSCALE(x) (x > .01 ? ((20 * log10f(x) + 40) / 6.60206) : 0)
-#define INV_GAINSCALE(x) (powf(10, .05*((x * 6.602059) - 40)))
+#define GAINSCALE(x) (x > .01 ? ((fast_coeff_to_db(x) + 40) / 6.60206) : 0)
+#define INV_GAINSCALE(x) (fast_db_to_coeff((x * 6.602059) - 40))
 
 using namespace LV2M;
 
@@ -292,6 +294,7 @@ static void alloc_sf(GMUI* ui) {
 
 
 static void draw_rb(GMUI* ui, gmringbuf *rb) {
+	DenormalGuard dg;
 	float d0, d1;
 	size_t n_samples = gmrb_read_space(rb);
 	if (n_samples < 64) return;
@@ -395,9 +398,6 @@ static void draw_rb(GMUI* ui, gmringbuf *rb) {
 #if 1 /* high pass filter */
 		ui->lp0 += ui->hpw * (d0 - ui->lp0);
 		ui->lp1 += ui->hpw * (d1 - ui->lp1);
-		/* prevent denormals */
-		ui->lp0 += 1e-12f;
-		ui->lp1 += 1e-12f;
 #else
 		ui->lp0 = d0;
 		ui->lp1 = d1;
@@ -23,6 +23,8 @@
 #include <string.h>
 #include <assert.h>
 
+#include "../jmeters/fastmath.h"
+
 #define RTK_URI "http://gareus.org/oss/lv2/meters#"
 #define RTK_GUI "kmeterui"
 #define MTR_URI RTK_URI
@@ -773,7 +775,7 @@ static void invalidate_hold(KMUI* ui, float val) {
  */
 
 static void handle_meter_connections(KMUI* ui, uint32_t port_index, float v) {
-	v = v > .000031623f ? 20.0 * log10f(v) : -90.0;
+	v = v > .000031623f ? LV2M::fast_coeff_to_db(v) : -90.0;
 	if (port_index == 3) {
 		invalidate_meter(ui, 0, v);
 	}
@@ -64,6 +64,7 @@ static const float c_grd[4] = {0.4, 0.4, 0.4, 1.0}; // grid color
 
 #include "../src/uri2.h"
 #include "fft.c"
+#include "../jmeters/denormal.h"
 
 #ifndef MIN
 #define MIN(A,B) ( (A) < (B) ? (A) : (B) )
@@ -142,6 +143,7 @@ typedef struct {
 
 	float phase[FFT_BINS_MAX];
 	float level[FFT_BINS_MAX];
+	float level_db[FFT_BINS_MAX];
 	float peak;
 	float pgain;
 
@@ -410,7 +412,7 @@ static void update_grid(MF2UI* ui) {
 		}
 
 		{
-			const float dr = ui->scale * PH_RAD * fast_log10(1.0 + 2 * freq * ui->log_rate / ui->rate) / ui->log_base;
+			const float dr = ui->scale * PH_RAD * LV2M::fast_log10(1.0 + 2 * freq * ui->log_rate / ui->rate) / ui->log_base;
 			cairo_arc (cr, ccc, ccc, dr, 0, 2.0 * M_PI);
 			cairo_stroke(cr);
 			const float px = ccc + dr * sinf(M_PI * -.75);
@@ -590,12 +592,13 @@ static void plot_data_fft(MF2UI* ui) {
 	const float dnum = ui->scale * PH_RAD / ui->log_base;
 	const float denom = ui->log_rate / (float)ui->fft_bins;
 	const float cutoff = ui->db_cutoff;
+	fftx_power_to_dB_array (ui->level_db, ui->level, ui->fft_bins);
 	for (uint32_t i = 1; i < ui->fft_bins-1 ; ++i) {
 		if (ui->level[i] < 0) continue;
-		const float level = gain + fftx_power_to_dB(ui->level[i]);
+		const float level = gain + ui->level_db[i];
 		if (level < cutoff) continue;
 
-		const float dist = dnum * fast_log10(1.0 + i * denom);
+		const float dist = dnum * LV2M::fast_log10(1.0 + i * denom);
 		const float dx = ccc + dist * sinf(ui->phase[i]);
 		const float dy = ccc - dist * cosf(ui->phase[i]);
 		const float pk = level > 0.0 ? 1.0 : (cutoff - level) / cutoff;
@@ -652,7 +655,7 @@ static void plot_data_oct(MF2UI* ui) {
 		if (a_level < cutoff) continue;
 
 		a_freq /= (float)a_cnt;
-		const float dist = dnum * fast_log10(1.0 + a_freq * denom);
+		const float dist = dnum * LV2M::fast_log10(1.0 + a_freq * denom);
 		const float pk = a_level > 0.0 ? 1.0 : (cutoff - a_level) / cutoff;
 
 		float dx, dy;
@@ -1305,6 +1308,7 @@ static void invalidate_pc(MF2UI* ui, const float val) {
 /******************************************************************************/
 
 static void process_audio(MF2UI* ui, const size_t n_elem, float const * const left, float const * const right) {
+	LV2M::DenormalGuard dg;
 	pthread_mutex_lock(&ui->fft_lock);
 
 	fftx_run(ui->fa, n_elem, left);
@@ -1330,7 +1334,7 @@ static void process_audio(MF2UI* ui, const size_t n_elem, float const * const le
 			}
 		}
 
-		ui->peak += .04 * (peak - ui->peak) + 1e-15;
+		ui->peak += .04 * (peak - ui->peak);
 		if (isnan (ui->peak)) { ui->peak = 0; }
 		if (ui->peak > 1000) { ui->peak = 1000; }
 		if (robtk_cbtn_get_active(ui->btn_norm)) {
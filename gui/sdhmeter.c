@@ -40,6 +40,7 @@
 
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
 #include "src/uris.h"
+#include "../jmeters/fastmath.h"
 
 /*************************/
 enum {
@@ -168,7 +169,7 @@ static inline float x_log_scale (const float v) {
 	if (v < 0.00316f) {
 		return 0;
 	} else {
-		const float l = log10f (v);
+		const float l = LV2M::fast_log10 (v);
 		return (l + 2.5) * (l + 2.5) * .16f;
 	}
 }
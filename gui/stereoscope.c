@@ -35,6 +35,7 @@ enum {
 
 #include "../src/uri2.h"
 #include "fft.c"
+#include "../jmeters/denormal.h"
 
 #ifndef MIN
 #define MIN(A,B) ( (A) < (B) ? (A) : (B) )
@@ -94,6 +95,7 @@ typedef struct {
 
 	float lr[FFT_BINS_MAX];
 	float level[FFT_BINS_MAX];
+	float level_db[FFT_BINS_MAX];
 
 	pthread_mutex_t fft_lock;
 
@@ -267,7 +269,7 @@ static void update_grid(SFSUI* ui) {
 	CairoSetSouerceRGBA(c_grd);
 
 #define FREQ_ANN(FRQ, TXT) { \
-	const float py = rintf(SS_BORDER + SS_SIZE * (1.0 - fast_log10(1.0 + 2 * FRQ * ui->log_rate / ui->rate) / ui->log_base)) + .5; \
+	const float py = rintf(SS_BORDER + SS_SIZE * (1.0 - LV2M::fast_log10(1.0 + 2 * FRQ * ui->log_rate / ui->rate) / ui->log_base)) + .5; \
 	cairo_move_to(cr, SS_BORDER, py); \
 	cairo_line_to(cr, SS_BORDER + SS_SIZE, py); \
 	cairo_stroke(cr); \
@@ -349,14 +351,15 @@ static void plot_data_fft(SFSUI* ui) {
 	const float denom = ui->log_rate / (float)ui->fft_bins;
 
 	cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+	fftx_power_to_dB_array (ui->level_db, ui->level, ui->fft_bins);
 	for (uint32_t i = 1; i < ui->fft_bins-1 ; ++i) {
 		if (ui->level[i] < 0) continue;
 
-		const float level = MAKEUP_GAIN + fftx_power_to_dB(ui->level[i]);
+		const float level = MAKEUP_GAIN + ui->level_db[i];
 		if (level < -80) continue;
 
-		const float y  = rintf(SS_BORDER + SS_SIZE - dnum * fast_log10(1.0 + i * denom)) + .5;
-		const float y1 = rintf(SS_BORDER + SS_SIZE - dnum * fast_log10(1.0 + (i+1) * denom)) + .5;
+		const float y  = rintf(SS_BORDER + SS_SIZE - dnum * LV2M::fast_log10(1.0 + i * denom)) + .5;
+		const float y1 = rintf(SS_BORDER + SS_SIZE - dnum * LV2M::fast_log10(1.0 + (i+1) * denom)) + .5;
 		const float pk = level > 0.0 ? 1.0 : (80 + level) / 80.0;
 		const float a_lr = ui->lr[i];
 
@@ -416,7 +419,7 @@ static void plot_data_oct(SFSUI* ui) {
 		a_freq /= (float)a_cnt;
 		a_lr /= (float)a_cnt;
 
-		const float y = rintf(SS_BORDER + SS_SIZE - dnum * fast_log10(1.0 + a_freq * denom)) + .5;
+		const float y = rintf(SS_BORDER + SS_SIZE - dnum * LV2M::fast_log10(1.0 + a_freq * denom)) + .5;
 		const float pk = a_level > 0.0 ? 1.0 : (80 + a_level) / 80.0;
 
 		float clr[3];
@@ -703,6 +706,7 @@ extension_data(const char* uri)
 /******************************************************************************/
 
 static void process_audio(SFSUI* ui, const size_t n_elem, float const * const left, float const * const right) {
+	LV2M::DenormalGuard dg;
 	pthread_mutex_lock(&ui->fft_lock);
 
 	fftx_run(ui->fa, n_elem, left);
@@ -723,17 +727,17 @@ static void process_audio(SFSUI* ui, const size_t n_elem, float const * const le
 			const float lr = .5 + .5 * (sqrtf(ui->fb->power[i]) - sqrtf(ui->fa->power[i])) / sqrtf(lv);
 #else
 			//XXX TODO log-scale / deflection of fraction
-			//const float lr = .5 + .25 * fast_log10(ui->fb->power[i] / ui->fa->power[i]);
+			//const float lr = .5 + .25 * LV2M::fast_log10(ui->fb->power[i] / ui->fa->power[i]);
 			float lr;
 			if (ui->fb->power[i] < ui->fa->power[i]) {
-				lr = .5 + .5 * fast_log10(ui->fb->power[i] / ui->fa->power[i]);
+				lr = .5 + .5 * LV2M::fast_log10(ui->fb->power[i] / ui->fa->power[i]);
 			} else {
-				lr = .5 - .5 * fast_log10(ui->fa->power[i] / ui->fb->power[i]);
+				lr = .5 - .5 * LV2M::fast_log10(ui->fa->power[i] / ui->fb->power[i]);
 			}
 #endif
 
-			ui->level[i] += .1 * (lv - ui->level[i]) + 1e-20;
-			ui->lr[i] += .1 * (lr - ui->lr[i]) + 1e-10;
+			ui->level[i] += .1 * (lv - ui->level[i]);
+			ui->lr[i] += .1 * (lr - ui->lr[i]);
 		}
 		queue_draw(ui->m0);
 	}
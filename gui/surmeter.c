@@ -29,6 +29,7 @@
 #define MTR_URI RTK_URI
 
 #include "lv2/lv2plug.in/ns/extensions/ui/ui.h"
+#include "../jmeters/fastmath.h"
 
 #ifndef MIN
 #define MIN(A,B) ( (A) < (B) ? (A) : (B) )
@@ -108,7 +109,7 @@ static float meter_deflect (const float coeff) {
 }
 
 static float db_deflect (const float dB) {
-	return meter_deflect (powf (10, .05 * dB));
+	return meter_deflect (LV2M::fast_db_to_coeff (dB));
 }
 
 /******************************************************************************
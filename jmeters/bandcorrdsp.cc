@@ -0,0 +1,204 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#include <math.h>
+#include <string.h>
+#include "simd.h"
+#include "bandcorrdsp.h"
+
+namespace LV2M {
+
+
+Bandcorrdsp::Bandcorrdsp (void) :
+    _nband (0),
+    _ngrp (0),
+    _grp (0)
+{
+}
+
+
+Bandcorrdsp::~Bandcorrdsp (void)
+{
+    delete[] _grp;
+}
+
+
+void Bandcorrdsp::process (const float *pl, const float *pr, int n)
+{
+    const bool silent = v4_silent (pl, n, silence_floor) && v4_silent (pr, n, silence_floor);
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	Band4 *B = _grp + g;
+
+	// Silence with the filters at rest: only the correlation
+	// filters decay, in closed form.
+	bool rest = silent;
+	for (int k = 0; rest && k < 16; k++)
+	{
+	    rest = fabsf (B->s1 [k / 4][k % 4]) <= silence_floor
+		&& fabsf (B->s2 [k / 4][k % 4]) <= silence_floor;
+	}
+	if (rest)
+	{
+	    for (int k = 0; k < 4; k++)
+	    {
+		const float d = (float) pow (1.0 - B->w [k], n);
+		B->zlr [k] *= d;
+		B->zll [k] *= d;
+		B->zrr [k] *= d;
+	    }
+	    continue;
+	}
+
+	const v4sf a1 = v4_load (B->a1);
+	const v4sf a2 = v4_load (B->a2);
+	const v4sf a3 = v4_load (B->a3);
+	const v4sf kk = v4_load (B->k);
+	const v4sf w  = v4_load (B->w);
+	v4sf s1 [4], s2 [4];
+	for (int j = 0; j < 4; j++)
+	{
+	    s1 [j] = v4_load (B->s1 [j]);
+	    s2 [j] = v4_load (B->s2 [j]);
+	}
+	v4sf zlr = v4_load (B->zlr);
+	v4sf zll = v4_load (B->zll);
+	v4sf zrr = v4_load (B->zrr);
+
+	for (int i = 0; i < n; i++)
+	{
+	    v4sf y [2];
+	    for (int c = 0; c < 2; c++)
+	    {
+		v4sf x = v4_set1 (c ? pr [i] : pl [i]);
+		for (int j = 2 * c; j < 2 * c + 2; j++)
+		{
+		    const v4sf v3 = x - s2 [j];
+		    const v4sf v1 = a1 * s1 [j] + a2 * v3;
+		    const v4sf v2 = s2 [j] + a2 * s1 [j] + a3 * v3;
+		    s1 [j] = 2.f * v1 - s1 [j];
+		    s2 [j] = 2.f * v2 - s2 [j];
+		    x = kk * v1;
+		}
+		y [c] = x;
+	    }
+	    zlr += w * (y [0] * y [1] - zlr);
+	    zll += w * (y [0] * y [0] - zll);
+	    zrr += w * (y [1] * y [1] - zrr);
+	}
+
+	for (int j = 0; j < 4; j++)
+	{
+	    v4_store (B->s1 [j], s1 [j]);
+	    v4_store (B->s2 [j], s2 [j]);
+	}
+	v4_store (B->zlr, zlr);
+	v4_store (B->zll, zll);
+	v4_store (B->zrr, zrr);
+
+	bool ok = true;
+	for (int k = 0; k < 4; k++)
+	{
+	    ok = ok && isfinite (B->zlr [k]) && isfinite (B->zll [k]) && isfinite (B->zrr [k]);
+	}
+	if (!ok) reset (B);
+    }
+}
+
+
+float Bandcorrdsp::read (int b) const
+{
+    const Band4 *B = _grp + b / 4;
+    const int k = b % 4;
+    return B->zlr [k] / sqrtf (B->zll [k] * B->zrr [k] + 1e-20f);
+}
+
+
+void Bandcorrdsp::reset (Band4 *B)
+{
+    memset (B->s1, 0, sizeof (B->s1));
+    memset (B->s2, 0, sizeof (B->s2));
+    memset (B->zlr, 0, sizeof (B->zlr));
+    memset (B->zll, 0, sizeof (B->zll));
+    memset (B->zrr, 0, sizeof (B->zrr));
+}
+
+
+void Bandcorrdsp::reset (void)
+{
+    for (int g = 0; g < _ngrp; g++) reset (_grp + g);
+}
+
+
+void Bandcorrdsp::init (int fsamp, int bpo, float tcf)
+{
+    // fsamp = sample frequency
+    // bpo   = bands per octave, 1 or 3
+    // tcf   = correlation filter time constant
+
+    int k0, k1;
+    if (bpo == 3)
+    {
+	k0 = -17;   // 20 Hz .. 20 kHz
+	k1 = 13;
+    }
+    else
+    {
+	bpo = 1;
+	k0 = -5;    // 31.5 Hz .. 16 kHz
+	k1 = 4;
+    }
+    _nband = k1 - k0 + 1;
+    _ngrp = (_nband + 3) / 4;
+
+    delete[] _grp;
+    _grp = new Band4 [_ngrp];
+    memset (_grp, 0, _ngrp * sizeof (Band4));
+
+    // Q of each section for -3dB of the cascade at the band
+    // edges, +-1/(2 bpo) octave, where adjacent bands meet.
+    const double r = pow (2.0, 0.5 / bpo);
+    const double q = sqrt (sqrt (2.0) - 1.0) / (r - 1.0 / r);
+
+    for (int b = 0; b < 4 * _ngrp; b++)
+    {
+	Band4 *B = _grp + b / 4;
+	const int j = b % 4;
+	double f = 0, t = tcf;
+	if (b < _nband)
+	{
+	    f = 1e3 * pow (2.0, (double)(k0 + b) / bpo);
+	    _freq [b] = (float) f;
+	    if (t < 10.0 / f) t = 10.0 / f;
+	}
+	const double g = (f < 0.45 * fsamp) ? tan (M_PI * f / fsamp) : 0.0;
+	const double a1 = 1.0 / (1.0 + g * (g + 1.0 / q));
+	B->a1 [j] = (float) a1;
+	B->a2 [j] = (float)(g * a1);
+	B->a3 [j] = (float)(g * g * a1);
+	B->k [j] = (float)(1.0 / q);
+	B->w [j] = (float)(1.0 / (t * fsamp));
+    }
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
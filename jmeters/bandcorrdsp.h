@@ -0,0 +1,81 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#ifndef __BANDCORRDSP_H
+#define	__BANDCORRDSP_H
+
+namespace LV2M {
+
+// Stereo correlation per octave or third-octave band.
+//
+// Each band is a fourth order bandpass, two identical state-variable
+// sections (trapezoidal integration, which stays accurate in single
+// precision down to the lowest bands). Adjacent bands cross at -3dB.
+// The band outputs feed a correlation filter as in Stcorrdsp; its time
+// constant is extended to ten periods for bands below 33Hz.
+//
+// Four bands are processed in the lanes of a vector. Bands above
+// 0.45 * fsamp are disabled and read as zero.
+
+class Bandcorrdsp
+{
+public:
+
+    enum { MAXBAND = 32 };
+
+    Bandcorrdsp (void);
+    ~Bandcorrdsp (void);
+
+    void  init (int fsamp, int bpo, float tcf);
+    void  process (const float *pl, const float *pr, int n);
+    float read (int b) const;
+    void  reset (void);
+
+    int   nband (void) const { return _nband; }
+    float freq (int b) const { return _freq [b]; }
+
+private:
+
+    struct Band4
+    {
+	float  a1 [4];           // filter coefficients
+	float  a2 [4];
+	float  a3 [4];
+	float  k [4];
+	float  w [4];            // correlation filter coefficient
+	float  s1 [4][4];        // filter states [channel * 2 + section][band]
+	float  s2 [4][4];
+	float  zlr [4];          // correlation filter states
+	float  zll [4];
+	float  zrr [4];
+    };
+
+    void   reset (Band4 *B);
+
+    int            _nband;       // number of bands
+    int            _ngrp;        // number of groups of four bands
+    Band4         *_grp;
+    float          _freq [MAXBAND]; // band center frequencies
+};
+
+};
+
+#endif
@@ -0,0 +1,74 @@
+/* meter.lv2 -- CPU feature dispatch
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cpuisa.h"
+
+namespace LV2M {
+
+static const char *names [] = { "generic", "avx2" };
+
+static int isa_detect (void)
+{
+    int level = ISA_GENERIC;
+
+#ifdef ISA_X86
+    __builtin_cpu_init ();
+    // The AVX2 kernels of the resampler also use FMA.
+    if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma")) level = ISA_AVX2;
+#endif
+
+    const char *env = getenv ("METERS_ISA");
+    if (env)
+    {
+	int l;
+	for (l = ISA_GENERIC; l <= ISA_AVX2; l++)
+	{
+	    if (!strcmp (env, names [l])) break;
+	}
+	if (l > ISA_AVX2)
+	{
+	    fprintf (stderr, "meters.lv2: unknown METERS_ISA '%s'\n", env);
+	}
+	else if (l > level)
+	{
+	    fprintf (stderr, "meters.lv2: METERS_ISA '%s' is not supported by this CPU\n", env);
+	}
+	else level = l;
+    }
+    return level;
+}
+
+
+int isa_level (void)
+{
+    // Initialized once, also if plugins are instantiated concurrently.
+    static const int level = isa_detect ();
+    return level;
+}
+
+
+const char *isa_name (int level)
+{
+    return (level >= ISA_GENERIC && level <= ISA_AVX2) ? names [level] : "?";
+}
+
+}
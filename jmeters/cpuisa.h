@@ -0,0 +1,58 @@
+/* meter.lv2 -- CPU feature dispatch
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __JMETER_CPUISA_H
+#define	__JMETER_CPUISA_H
+
+/* The library is built for the baseline of the target (SSE2 on x86).
+ * Hot kernels additionally have variants for newer instruction sets,
+ * compiled with a function target attribute and selected at init()
+ * time from isa_level ().
+ *
+ * The environment variable METERS_ISA ("generic" or "avx2") forces a
+ * lower level for benchmarking; a level the CPU does not support is
+ * ignored.
+ *
+ * Variants do not enable FMA, readings are bit-identical to the
+ * generic kernels.
+ */
+
+#if defined (__GNUC__) && (defined (__x86_64__) || defined (__i386__))
+# define ISA_X86
+/* wrapper that inlines the generic kernel, compiled for AVX2 */
+# define ISA_AVX2_TARGET __attribute__ ((target ("avx2"), flatten))
+/* Kernels on 8 lane vectors pass them by value to the AVX2 helpers of
+ * simd.h, so they must be compiled for AVX2 too: they are inlined into
+ * their wrapper at any optimization level, and with GCC their v8sf
+ * instantiations are also explicitly compiled for AVX2. */
+# define ISA_INLINE inline __attribute__ ((always_inline))
+#else
+# define ISA_INLINE inline
+#endif
+
+namespace LV2M {
+
+enum Isa { ISA_GENERIC, ISA_AVX2 };
+
+int isa_level (void);
+const char *isa_name (int level);
+
+};
+
+#endif
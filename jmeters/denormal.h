@@ -0,0 +1,74 @@
+/* meter.lv2 -- scoped flush-to-zero
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __JMETER_DENORMAL_H
+#define	__JMETER_DENORMAL_H
+
+/* Flush denormals to zero for the lifetime of the object, the previous
+ * floating point mode is restored on destruction. One of these at the
+ * top of every plugin run() and UI analysis call replaces the constants
+ * that were added in the filter loops to keep their state normal.
+ *
+ * x86: MXCSR FTZ and DAZ, ARM: FPCR/FPSCR FZ. Elsewhere a no-op.
+ */
+
+#if defined (__SSE__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP > 0)
+# include <xmmintrin.h>
+#endif
+
+namespace LV2M {
+
+class DenormalGuard
+{
+public:
+
+#if defined (__SSE__) || defined (_M_X64) || (defined (_M_IX86_FP) && _M_IX86_FP > 0)
+    DenormalGuard (void) : _mode (_mm_getcsr ()) { _mm_setcsr (_mode | 0x8040); }
+    ~DenormalGuard (void) { _mm_setcsr (_mode); }
+private:
+    unsigned int _mode;
+#elif defined (__aarch64__)
+    DenormalGuard (void)
+    {
+	__asm__ __volatile__ ("mrs %0, fpcr" : "=r" (_mode));
+	__asm__ __volatile__ ("msr fpcr, %0" : : "r" (_mode | (1ULL << 24)));
+    }
+    ~DenormalGuard (void) { __asm__ __volatile__ ("msr fpcr, %0" : : "r" (_mode)); }
+private:
+    unsigned long long _mode;
+#elif defined (__arm__) && defined (__ARM_FP)
+    DenormalGuard (void)
+    {
+	__asm__ __volatile__ ("vmrs %0, fpscr" : "=r" (_mode));
+	__asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (_mode | (1U << 24)));
+    }
+    ~DenormalGuard (void) { __asm__ __volatile__ ("vmsr fpscr, %0" : : "r" (_mode)); }
+private:
+    unsigned int _mode;
+#else
+    DenormalGuard (void) {}
+#endif
+
+    DenormalGuard (const DenormalGuard&);
+    DenormalGuard& operator= (const DenormalGuard&);
+};
+
+};
+
+#endif
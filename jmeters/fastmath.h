@@ -0,0 +1,215 @@
+/* meter.lv2 -- fast log/exp approximations for level <-> dB conversion
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __JMETER_FASTMATH_H
+#define	__JMETER_FASTMATH_H
+
+#include "simd.h"
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+/* Polynomial log2 and exp2, scalar and four lanes, and the dB
+ * conversions built on them. Scalar and vector versions use the same
+ * operations and return identical results.
+ *
+ * Measured maximum error, over all normal floats unless noted. Most of
+ * it is the rounding of the float result (or argument), the polynomials
+ * themselves are accurate to 2.2e-6 (log2) and 8e-8 (exp2):
+ *
+ *   fast_log2 (x)        absolute 6.0e-6, exact for x = 1
+ *   fast_log10 (x)       absolute 5.5e-6
+ *   fast_exp2 (x)        relative 1.8e-7
+ *   fast_pow (x, y)      relative 1.5e-6 * (1 + |y|), x in [1e-3, 1e2]
+ *   fast_coeff_to_db     absolute 7.5e-5 dB, 3.5e-5 dB for c in [1e-12, 1e6]
+ *   fast_power_to_db     absolute 3.8e-5 dB, 1.7e-5 dB for p in [1e-12, 1e6]
+ *   fast_db_to_coeff     relative 1.6e-6 for -240..+120 dB
+ *   fast_sqrt, v4_sqrt   exact (IEEE square root)
+ *
+ * The logarithms ignore the sign of x; zero and denormals return about
+ * -127 (-765 dB), so callers apply their own floor. exp2 clamps its
+ * argument to [-126, 128).
+ */
+
+namespace LV2M {
+
+#define FM_LOG2_C1  1.442713481e+00f
+#define FM_LOG2_C2 -7.211318583e-01f
+#define FM_LOG2_C3  4.793480187e-01f
+#define FM_LOG2_C4 -3.674899795e-01f
+#define FM_LOG2_C5  3.221548007e-01f
+#define FM_LOG2_C6 -2.065917360e-01f
+
+#define FM_EXP2_C1  6.931513118e-01f
+#define FM_EXP2_C2  2.401644503e-01f
+#define FM_EXP2_C3  5.579991277e-02f
+#define FM_EXP2_C4  9.017030724e-03f
+#define FM_EXP2_C5  1.867129903e-03f
+
+#define FM_DB_PER_LOG2   6.020599913f   // 20 * log10 (2)
+#define FM_LOG2_PER_DB   0.1660964047f  // log2 (10) / 20
+#define FM_LOG10_PER_LOG2 0.3010299957f
+
+static inline float fast_log2 (float x)
+{
+    int32_t i;
+    memcpy (&i, &x, sizeof (i));
+    // split x = 2^e * m with m in [sqrt(.5), sqrt(2))
+    i &= 0x7fffffff;
+    const int32_t e = (i - 0x3f3504f3) >> 23;
+    i -= (int32_t)((uint32_t) e << 23);
+    float m;
+    memcpy (&m, &i, sizeof (m));
+    const float t = m - 1.f;
+    const float p = t * (FM_LOG2_C1 + t * (FM_LOG2_C2 + t * (FM_LOG2_C3
+		  + t * (FM_LOG2_C4 + t * (FM_LOG2_C5 + t * FM_LOG2_C6)))));
+    return p + (float) e;
+}
+
+static inline float fast_exp2 (float x)
+{
+    if (!(x > -126.f)) x = -126.f;  // also catches NaN
+    if (x > 127.99f) x = 127.99f;
+    int32_t i = (int32_t) x;
+    if ((float) i > x) --i;
+    const float f = x - (float) i;
+    const float p = 1.f + f * (FM_EXP2_C1 + f * (FM_EXP2_C2 + f * (FM_EXP2_C3
+		  + f * (FM_EXP2_C4 + f * FM_EXP2_C5))));
+    i = (i + 127) << 23;
+    float s;
+    memcpy (&s, &i, sizeof (s));
+    return p * s;
+}
+
+static inline float fast_log10 (float x)
+{
+    return fast_log2 (x) * FM_LOG10_PER_LOG2;
+}
+
+/* x > 0 */
+static inline float fast_pow (float x, float y)
+{
+    return fast_exp2 (y * fast_log2 (x));
+}
+
+static inline float fast_sqrt (float x)
+{
+    return sqrtf (x);
+}
+
+/* 20 * log10 (c) */
+static inline float fast_coeff_to_db (float c)
+{
+    return fast_log2 (c) * FM_DB_PER_LOG2;
+}
+
+/* 10 * log10 (p) */
+static inline float fast_power_to_db (float p)
+{
+    return fast_log2 (p) * (.5f * FM_DB_PER_LOG2);
+}
+
+/* 10^(db / 20) */
+static inline float fast_db_to_coeff (float db)
+{
+    return fast_exp2 (db * FM_LOG2_PER_DB);
+}
+
+static inline v4sf v4_log2 (v4sf x)
+{
+    const v4si a = (v4si) x & 0x7fffffff;
+    const v4si e = (a - 0x3f3504f3) >> 23;
+    const v4sf t = (v4sf)(a - (e << 23)) - 1.f;
+    const v4sf p = t * (FM_LOG2_C1 + t * (FM_LOG2_C2 + t * (FM_LOG2_C3
+		 + t * (FM_LOG2_C4 + t * (FM_LOG2_C5 + t * FM_LOG2_C6)))));
+    return p + __builtin_convertvector (e, v4sf);
+}
+
+static inline v4sf v4_exp2 (v4sf x)
+{
+    const v4sf lo = v4_set1 (-126.f);
+    const v4sf hi = v4_set1 (127.99f);
+    x = v4_select (x > lo, x, lo);
+    x = v4_select (x < hi, x, hi);
+    v4si i = __builtin_convertvector (x, v4si);
+    i += (v4si)(__builtin_convertvector (i, v4sf) > x); // floor, adds -1
+    const v4sf f = x - __builtin_convertvector (i, v4sf);
+    const v4sf p = 1.f + f * (FM_EXP2_C1 + f * (FM_EXP2_C2 + f * (FM_EXP2_C3
+		 + f * (FM_EXP2_C4 + f * FM_EXP2_C5))));
+    return p * (v4sf)((i + 127) << 23);
+}
+
+static inline v4sf v4_sqrt (v4sf x)
+{
+#ifdef __SSE__
+    return (v4sf) _mm_sqrt_ps ((__m128) x);
+#else
+    v4sf r = { sqrtf (x [0]), sqrtf (x [1]), sqrtf (x [2]), sqrtf (x [3]) };
+    return r;
+#endif
+}
+
+/* Batch conversion of n values, dst may equal src. Results at or below
+ * floor_db are replaced by fill (e.g. the floor itself, or -INFINITY).
+ */
+static inline void fast_to_db (float *dst, const float *src, int n, float scale, float floor_db, float fill)
+{
+    const v4sf s = v4_set1 (scale);
+    const v4sf fl = v4_set1 (floor_db);
+    const v4sf fi = v4_set1 (fill);
+    int i;
+    for (i = 0; i + 4 <= n; i += 4)
+    {
+	const v4sf d = v4_log2 (v4_load (src + i)) * s;
+	v4_store (dst + i, v4_select (d > fl, d, fi));
+    }
+    for (; i < n; i++)
+    {
+	const float d = fast_log2 (src [i]) * scale;
+	dst [i] = d > floor_db ? d : fill;
+    }
+}
+
+static inline void fast_coeff_to_db (float *dst, const float *src, int n, float floor_db, float fill)
+{
+    fast_to_db (dst, src, n, FM_DB_PER_LOG2, floor_db, fill);
+}
+
+static inline void fast_power_to_db (float *dst, const float *src, int n, float floor_db, float fill)
+{
+    fast_to_db (dst, src, n, .5f * FM_DB_PER_LOG2, floor_db, fill);
+}
+
+static inline void fast_db_to_coeff (float *dst, const float *src, int n)
+{
+    const v4sf s = v4_set1 (FM_LOG2_PER_DB);
+    int i;
+    for (i = 0; i + 4 <= n; i += 4)
+    {
+	v4_store (dst + i, v4_exp2 (v4_load (src + i) * s));
+    }
+    for (; i < n; i++)
+    {
+	dst [i] = fast_db_to_coeff (src [i]);
+    }
+}
+
+};
+
+#endif
@@ -18,14 +18,11 @@
 */
 
 #include <math.h>
+#include "simd.h"
 #include "kmeterdsp.h"
 
 namespace LV2M {
 
-float  Kmeterdsp::_omega;
-int    Kmeterdsp::_hold;
-float  Kmeterdsp::_fsamp;
-
 
 Kmeterdsp::Kmeterdsp (void) :
     _z1 (0),
@@ -35,7 +32,12 @@ Kmeterdsp::Kmeterdsp (void) :
     _cnt (0),
     _fpp (0),
     _fall (0),
-    _flag (false)
+    _flag (false),
+    _k (0),
+    _omega (0),
+    _d4 (0),
+    _hold (0),
+    _fsamp (0)
 {
 }
 
@@ -51,6 +53,18 @@ void Kmeterdsp::init (float fsamp)
 
     _hold = (int)(hold * fsamp + 0.5f); // number of samples to hold peak
     _omega = 9.72f / fsamp; // ballistic filter coefficient
+
+    // The first filter is evaluated four samples at a time:
+    // z1 [i+4] = z1 [i] + sum (w * a^(3-k) * s [i+k]) - (1 - a^4) * z1 [i],
+    // with a = 1 - w. The weights are normalized to unity DC gain with the
+    // rounded (1 - a^4), which is kept instead of a^4 for a precise decay.
+    const double a = 1.0 - _omega;
+    _d4 = (float)(1.0 - a * a * a * a);
+    const double g = _d4 / (1.0 - a * a * a * a);
+    for (int k = 0; k < 4; k++)
+    {
+	_c [k] = (float)(g * _omega * pow (a, 3 - k));
+    }
 }
 
 void Kmeterdsp::process (float *p, int n)
@@ -61,6 +75,7 @@ void Kmeterdsp::process (float *p, int n)
     // n : number of samples to process
 
     float  s, t, z1, z2;
+    int    i, k;
 
     if (_fpp != n) {
 	const float fall = 15.0f;
@@ -76,35 +91,76 @@ void Kmeterdsp::process (float *p, int n)
 
     // Perform filtering. The second filter is evaluated
     // only every 4th sample - this is just an optimisation.
-    n /= 4;  // Loop is unrolled by 4.
-    while (n--)
+    k = _k;
+    // Complete the group of four left open by the previous cycle.
+    while (k && n)
     {
 	s = *p++;
 	s *= s;
 	if (t < s) t = s;             // Update digital peak.
 	z1 += _omega * (s - z1);      // Update first filter.
-	s = *p++;
-	s *= s;
-	if (t < s) t = s;             // Update digital peak.
-	z1 += _omega * (s - z1);      // Update first filter.
-	s = *p++;
-	s *= s;
-	if (t < s) t = s;             // Update digital peak.
-	z1 += _omega * (s - z1);      // Update first filter.
-	s = *p++;
-	s *= s;
-	if (t < s) t = s;             // Update digital peak.
-	z1 += _omega * (s - z1);      // Update first filter.
+	n--;
+	if (++k == 4)
+	{
+	    z2 += 4 * _omega * (z1 - z2); // Update second filter.
+	    k = 0;
+	}
+    }
+
+    // Silence: z1 decays by a = 1 - _d4 per group, and after m groups
+    // z2 = b^m * z2 + 4 * _omega * z1 * sum (b^(m-j) * a^j), j = 1..m
+    // with b = 1 - 4 * _omega.
+    i = n / 4;
+    if (i > 1 && v4_silent (p, 4 * i, silence_floor))
+    {
+	const double a = 1.0 - _d4;
+	const double b = 1.0 - 4 * _omega;
+	const double am = pow (a, i);
+	const double bm = pow (b, i);
+	const double sm = (a != b) ? a * (am - bm) / (a - b) : i * am;
+	z2 = z2 * (float) bm + (float)(4 * _omega * sm) * z1;
+	z1 *= (float) am;
+	p += 4 * i;
+	n -= 4 * i;
+    }
+
+    // Only the value of z1 at the end of each group is used, so the
+    // serial chain is one multiply and add per four samples.
+    const v4sf c = v4_load (_c);
+    v4sf x, vt = v4_set1 (0);
+    for (i = n / 4; i; i--)
+    {
+	x = v4_load (p);
+	p += 4;
+	x *= x;
+	vt = v4_max (x, vt);          // Update digital peak.
+	z1 += v4_hsum (c * x) - _d4 * z1; // Update first filter.
         z2 += 4 * _omega * (z1 - z2); // Update second filter.
     }
+    s = v4_hmax (vt);
+    if (t < s) t = s;
+
+    // The second filter of a group not completed in this cycle
+    // is updated at the start of the next one.
+    if (n & 3)
+    {
+	for (k = n & 3, i = k; i; i--)
+	{
+	    s = *p++;
+	    s *= s;
+	    if (t < s) t = s;             // Update digital peak.
+	    z1 += _omega * (s - z1);      // Update first filter.
+	}
+    }
+    _k = k;
 
     if (isnan(z1)) z1 = 0;
     if (isnan(z2)) z2 = 0;
     if (!isfinite(t)) t = 0;
 
-    // Save filter state. The added constants avoid denormals.
-    _z1 = z1 + 1e-20f;
-    _z2 = z2 + 1e-20f;
+    // Save filter state.
+    _z1 = z1;
+    _z2 = z2;
 
     s = sqrtf (2.0f * z2);
     t = sqrtf (t);
@@ -158,6 +214,7 @@ void Kmeterdsp::reset ()
 {
     _z1 = _z2 = _rms = _peak = .0f;
     _cnt = 0;
+    _k = 0;
     _flag = false;
 }
 
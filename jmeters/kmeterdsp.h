@@ -46,10 +46,13 @@ private:
 		int            _fpp;	       // frames per period
 		float          _fall;        // peak fallback
 		bool           _flag;        // flag set by read(), resets _rms
+		int            _k;           // samples into the current group of 4
 
-		static float   _omega;       // ballistics filter constant.
-		static int     _hold;        // peak hold timeoute
-		static float   _fsamp;       // sample-rate
+		float          _omega;       // ballistics filter constant.
+		float          _d4;          // 1 - (1 - _omega)^4
+		float          _c [4];       // _omega * (1 - _omega)^(3-k)
+		int            _hold;        // peak hold timeoute
+		float          _fsamp;       // sample-rate
 
 };
 
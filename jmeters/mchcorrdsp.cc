@@ -0,0 +1,293 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#include <math.h>
+#include <string.h>
+#include "simd.h"
+#include "mchcorrdsp.h"
+
+namespace LV2M {
+
+
+Mchcorrdsp::Mchcorrdsp (void) :
+    _nchan (0),
+    _ncol (0),
+    _zl (0),
+    _z (0),
+    _y (0),
+    _cmin (0),
+    _w1 (0)
+{
+    for (int k = 0; k < NTC; k++) _w2 [k] = _d2 [k] = 0;
+}
+
+
+Mchcorrdsp::~Mchcorrdsp (void)
+{
+    delete[] _zl;
+    delete[] _z;
+    delete[] _y;
+    delete[] _cmin;
+}
+
+
+void Mchcorrdsp::process (float * const *p, int n)
+{
+    const int nc = _nchan;
+    const int C = _ncol;
+    const int Z = nc * C;
+    float *zl = _zl;
+    float *y = _y;
+    int   i, g;
+
+    i = 0;
+
+    // Silence, closed form as in Stcorrdsp.
+    g = n / 4;
+    bool silent = g > 1;
+    for (int c = 0; silent && c < nc; c++)
+    {
+	silent = v4_silent (p [c], 4 * g, silence_floor);
+    }
+    if (silent)
+    {
+	const double a = 1.0 - _d1 [3];
+	const double am = pow (a, g);
+	for (int t = 0; t < NTC; t++)
+	{
+	    float *z = _z + t * Z;
+	    const double b = 1.0 - _d2 [t];
+	    const double bm = pow (b, g);
+	    double s = 0;
+	    for (int k = 0; k < 4; k++) s += _m2 [t][k] * (1.0 - _d1 [k]) * (1.0 - _d1 [k]);
+	    s *= (a * a != b) ? (bm - am * am) / (b - a * a) : g * bm / b;
+	    for (int r = 0; r < nc; r++)
+	    {
+		for (int c = 0; c < C; c++)
+		{
+		    z [r * C + c] = (float)(bm * z [r * C + c] + s * zl [r] * zl [c]);
+		}
+	    }
+	}
+	for (int c = 0; c < nc; c++) zl [c] = (float)(am * zl [c]);
+	i = 4 * g;
+    }
+
+    // Four samples at a time. Four channels are filtered in the lanes
+    // of a vector, giving the lowpass outputs y [k * C + c] for sample
+    // k of the group. A row of the matrix, z [r][c..c+3], is then
+    // updated from one broadcast and one vector load per sample.
+    for (; i + 4 <= n; i += 4)
+    {
+	for (int c = 0; c < C; c += 4)
+	{
+	    const float *q [4];
+	    for (int k = 0; k < 4; k++) q [k] = p [(c + k < nc) ? c + k : c];
+	    const v4sf x0 = Lanes<v4sf>::gather (q, i);
+	    const v4sf x1 = Lanes<v4sf>::gather (q, i + 1);
+	    const v4sf x2 = Lanes<v4sf>::gather (q, i + 2);
+	    const v4sf x3 = Lanes<v4sf>::gather (q, i + 3);
+	    const v4sf u = v4_load (zl + c);
+	    v4sf v;
+	    for (int k = 0; k < 4; k++)
+	    {
+		v = u + (((_m1 [0][k] * x0 + _m1 [1][k] * x1)
+			+ (_m1 [2][k] * x2 + _m1 [3][k] * x3)) - _d1 [k] * u);
+		v4_store (y + k * C + c, v);
+	    }
+	    v4_store (zl + c, v);
+	}
+	for (int t = 0; t < NTC; t++)
+	{
+	    float *z = _z + t * Z;
+	    const float *m2 = _m2 [t];
+	    const v4sf d2 = v4_set1 (_d2 [t]);
+	    for (int r = 0; r < nc; r++)
+	    {
+		const v4sf u0 = v4_set1 (m2 [0] * y [r]);
+		const v4sf u1 = v4_set1 (m2 [1] * y [C + r]);
+		const v4sf u2 = v4_set1 (m2 [2] * y [2 * C + r]);
+		const v4sf u3 = v4_set1 (m2 [3] * y [3 * C + r]);
+		for (int c = r & ~3; c < C; c += 4)
+		{
+		    const v4sf q = (u0 * v4_load (y + c) + u1 * v4_load (y + C + c))
+				 + (u2 * v4_load (y + 2 * C + c) + u3 * v4_load (y + 3 * C + c));
+		    v4sf zz = v4_load (z + r * C + c);
+		    zz += q - d2 * zz;
+		    v4_store (z + r * C + c, zz);
+		}
+	    }
+	}
+    }
+
+    for (; i < n; i++)
+    {
+	for (int c = 0; c < nc; c++)
+	{
+	    zl [c] += _w1 * (p [c][i] - zl [c]);
+	}
+	for (int t = 0; t < NTC; t++)
+	{
+	    float *z = _z + t * Z;
+	    const v4sf w2 = v4_set1 (_w2 [t]);
+	    for (int r = 0; r < nc; r++)
+	    {
+		const v4sf u = v4_set1 (zl [r]);
+		for (int c = r & ~3; c < C; c += 4)
+		{
+		    v4sf zz = v4_load (z + r * C + c);
+		    zz += w2 * (u * v4_load (zl + c) - zz);
+		    v4_store (z + r * C + c, zz);
+		}
+	    }
+	}
+    }
+
+    for (int c = 0; c < nc; c++)
+    {
+	if (!isfinite (zl [c])) zl [c] = 0;
+    }
+    for (int k = 0; k < NTC * Z; k++)
+    {
+	if (!isfinite (_z [k])) _z [k] = 0;
+    }
+
+    // -60dB on both inputs, as in Stcorrdsp
+    for (int a = 0; a < nc; a++)
+    {
+	if (_z [a * C + a] <= 1e-6f) continue;
+	for (int b = a + 1; b < nc; b++)
+	{
+	    if (_z [b * C + b] <= 1e-6f) continue;
+	    const float c = read (a, b);
+	    if (c < _cmin [a * C + b]) _cmin [a * C + b] = c;
+	}
+    }
+}
+
+
+float Mchcorrdsp::read (int a, int b, int k) const
+{
+    if (a > b)
+    {
+	const int t = a;
+	a = b;
+	b = t;
+    }
+    const int C = _ncol;
+    const float *z = _z + k * _nchan * C;
+    return z [a * C + b] / sqrtf (z [a * C + a] * z [b * C + b] + 1e-10f);
+}
+
+
+float Mchcorrdsp::read_min (int a, int b) const
+{
+    if (a > b)
+    {
+	const int t = a;
+	a = b;
+	b = t;
+    }
+    return _cmin [a * _ncol + b];
+}
+
+
+int Mchcorrdsp::read (float *r) const
+{
+    int k = 0;
+    for (int a = 0; a < _nchan; a++)
+    {
+	for (int b = a + 1; b < _nchan; b++)
+	{
+	    r [k++] = read (a, b);
+	}
+    }
+    return k;
+}
+
+
+void Mchcorrdsp::reset (void)
+{
+    memset (_zl, 0, _ncol * sizeof (float));
+    memset (_z, 0, NTC * _nchan * _ncol * sizeof (float));
+    reset_min ();
+}
+
+
+void Mchcorrdsp::reset_min (void)
+{
+    for (int k = 0; k < _nchan * _ncol; k++) _cmin [k] = 1.0f;
+}
+
+
+void Mchcorrdsp::init (int nchan, int fsamp, float flp, float tcf, float tcfast, float tcslow)
+{
+    // nchan  = number of channels, at most MAXCHAN
+    // fsamp  = sample frequency
+    // flp    = lowpass frequency
+    // tcf    = correlation filter time constant
+    // tcfast = time constant of the fast correlation filter
+    // tcslow = time constant of the slow correlation filter
+
+    const float tc [NTC] = { tcf, tcfast, tcslow };
+
+    if (nchan > MAXCHAN) nchan = MAXCHAN;
+    _nchan = nchan;
+    _ncol = (nchan + 3) & ~3;
+
+    delete[] _zl;
+    delete[] _z;
+    delete[] _y;
+    delete[] _cmin;
+    _zl = new float [_ncol];
+    _z = new float [NTC * _nchan * _ncol];
+    _y = new float [4 * _ncol];
+    _cmin = new float [_nchan * _ncol];
+    memset (_y, 0, 4 * _ncol * sizeof (float));
+    reset ();
+
+    _w1 = 6.28f * flp / fsamp;
+
+    const double a = 1.0 - _w1;
+    for (int k = 0; k < 4; k++)
+    {
+	const double d = 1.0 - pow (a, k + 1);
+	_d1 [k] = (float) d;
+	for (int j = 0; j < 4; j++)
+	{
+	    _m1 [j][k] = (j <= k) ? (float)(_d1 [k] / d * _w1 * pow (a, k - j)) : 0.0f;
+	}
+    }
+    for (int t = 0; t < NTC; t++)
+    {
+	_w2 [t] = 1 / (tc [t] * fsamp);
+	const double b = 1.0 - _w2 [t];
+	_d2 [t] = (float)(1.0 - pow (b, 4));
+	for (int k = 0; k < 4; k++)
+	{
+	    _m2 [t][k] = (float)(_d2 [t] / (1.0 - pow (b, 4)) * _w2 [t] * pow (b, 3 - k));
+	}
+    }
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
@@ -0,0 +1,83 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#ifndef __MCHCORRDSP_H
+#define	__MCHCORRDSP_H
+
+namespace LV2M {
+
+// Correlation of all pairs of up to MAXCHAN channels, using the filters
+// of Stcorrdsp. Each channel is lowpass filtered once; the cross
+// products of all pairs are accumulated row by row, four columns of
+// the matrix per vector, so the work per sample grows with the number
+// of matrix rows and not with the number of scalar pair passes.
+//
+// As in Stcorrdsp, there are a main, a fast and a slow correlation
+// filter for each pair, and the minimum of the main reading is kept.
+// For a < b, read (a, b, k) and read_min (a, b) are bit-identical to
+// a Stcorrdsp fed with channel a as left and channel b as right input
+// (tools/test_blocksize).
+
+class Mchcorrdsp
+{
+public:
+
+    enum { MAXCHAN = 8 };
+    enum { MAIN, FAST, SLOW, NTC };
+
+    Mchcorrdsp (void);
+    ~Mchcorrdsp (void);
+
+    void  init (int nchan, int fsamp, float flp, float tcf, float tcfast = 0.05f, float tcslow = 3.0f);
+    void  process (float * const *p, int n);
+    float read (int a, int b, int k = MAIN) const;
+    int   read (float *r) const;
+    float read_min (int a, int b) const;
+    void  reset (void);
+    void  reset_min (void);
+
+    int   nchan (void) const { return _nchan; }
+    int   npair (void) const { return _nchan * (_nchan - 1) / 2; }
+
+private:
+
+    int            _nchan;       // number of channels
+    int            _ncol;        // row length, _nchan rounded up to 4
+
+    float         *_zl;          // lowpass filter states [_ncol]
+    float         *_z;           // correlation filter states [NTC][_nchan][_ncol]
+    float         *_y;           // lowpass outputs of a group [4][_ncol]
+    float         *_cmin;        // minimum of the main readings [_nchan][_ncol]
+
+    float          _w1;          // lowpass filter coefficient
+    float          _w2 [NTC];    // correlation filter coeffients
+
+    // The same filters evaluated four samples at a time, see Stcorrdsp.
+    float          _d1 [4];      // 1 - (1 - _w1)^(k+1)
+    float          _m1 [4][4];   // lowpass input weights [j][k]
+    float          _d2 [NTC];    // 1 - (1 - _w2)^4
+    float          _m2 [NTC][4]; // correlation filter input weights
+};
+
+};
+
+#endif
@@ -0,0 +1,662 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#include <math.h>
+#include "simd.h"
+#include "mchjmeterdsp.h"
+
+namespace LV2M {
+
+Mchjmeterdsp::Mchjmeterdsp (void) :
+    _type (VU),
+    _nchan (0),
+    _nlane (0),
+    _ngrp (0),
+    _z1 (0),
+    _z2 (0),
+    _m (0),
+    _res (0),
+    _k (0),
+    _vlr (0),
+    _vth (0),
+    _rms (0),
+    _peak (0),
+    _cnt (0),
+    _fpp (0),
+    _fall (0),
+    _proc (0)
+{
+}
+
+
+Mchjmeterdsp::~Mchjmeterdsp (void)
+{
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _m;
+    delete[] _res;
+    delete[] _rms;
+    delete[] _peak;
+    delete[] _cnt;
+}
+
+
+void Mchjmeterdsp::init (int type, int nchan, float fsamp)
+{
+    _type = type;
+    _nchan = nchan;
+    _fsamp = fsamp;
+
+    // Mono and stereo get dedicated kernels with one and two lanes,
+    // anything larger is processed in groups of four channels, or
+    // eight if the CPU has AVX2.
+    switch (nchan)
+    {
+    case 1:  _nlane = 1; break;
+    case 2:  _nlane = 2; break;
+    default: _nlane = 4; break;
+    }
+#ifdef ISA_X86
+    if (nchan > 4 && isa_level () >= ISA_AVX2) _nlane = 8;
+#endif
+    _ngrp = (nchan + _nlane - 1) / _nlane;
+
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _m;
+    delete[] _res;
+    delete[] _rms;
+    delete[] _peak;
+    delete[] _cnt;
+    _z1 = new float [_nlane * _ngrp];
+    _z2 = new float [_nlane * _ngrp];
+    _m = new float [_nlane * _ngrp];
+    _res = new bool [_nchan];
+    _rms = new float [_nchan];
+    _peak = new float [_nchan];
+    _cnt = new int [_nchan];
+
+    // Same coefficients as the corresponding scalar class.
+    switch (_type)
+    {
+    case VU:
+	_w1 = 11.1f / fsamp;
+	_g = 1.5f * 1.571f;
+	{
+	    // With zero input a group of four samples is a linear map of
+	    // (z1, z2). Its eigenvalues are complex for any practical
+	    // sample-rate, the response is a damped oscillation.
+	    const double a = 1.0 - _w1;
+	    const double a4 = a * a * a * a;
+	    const double w4 = 4 * _w1;
+	    _vm [0][0] = a4;
+	    _vm [0][1] = -0.5 * (1 - a4);
+	    _vm [1][0] = w4 * a4;
+	    _vm [1][1] = 1 - w4 - 0.5 * w4 * (1 - a4);
+	    const double t = 0.5 * (_vm [0][0] + _vm [1][1]);
+	    const double d = _vm [0][0] * _vm [1][1] - _vm [0][1] * _vm [1][0];
+	    if (d > 0 && t * t < d)
+	    {
+		_vlr = 0.5 * log (d);
+		_vth = acos (t / sqrt (d));
+	    }
+	    else _vth = 0;
+	}
+	break;
+    case IEC1:
+	_w1 =  450.0f / fsamp;
+	_w2 = 1300.0f / fsamp;
+	_w3 = 1.0f - 5.4f / fsamp;
+	_g = 0.5108f;
+	break;
+    case IEC2:
+	_w1 = 200.0f / fsamp;
+	_w2 = 860.0f / fsamp;
+	_w3 = 1.0f - 4.0f / fsamp;
+	_g = 0.5141f;
+	break;
+    case KMETER:
+	_hold = (int)(0.5f * fsamp + 0.5f);
+	_w1 = 9.72f / fsamp;
+	{
+	    // First filter over groups of four samples, see Kmeterdsp.
+	    const double a = 1.0 - _w1;
+	    _d4 = (float)(1.0 - a * a * a * a);
+	    const double g = _d4 / (1.0 - a * a * a * a);
+	    for (int k = 0; k < 4; k++) _c [k] = (float)(g * _w1 * pow (a, 3 - k));
+	}
+	break;
+    }
+
+    switch (_nlane)
+    {
+    case 1:  select_kernel <float> (); break;
+    case 2:  select_kernel <v2sf> (); break;
+    case 4:  select_kernel <v4sf> (); break;
+#ifdef ISA_X86
+    case 8:  select_avx2 (); break;
+#endif
+    }
+    reset ();
+}
+
+
+template <typename V>
+void Mchjmeterdsp::select_kernel (void)
+{
+    switch (_type)
+    {
+    case VU:
+	_proc = &Mchjmeterdsp::process_vu <V>;
+	break;
+    case IEC1:
+    case IEC2:
+	_proc = &Mchjmeterdsp::process_iec <V>;
+	break;
+    case KMETER:
+	_proc = &Mchjmeterdsp::process_km <V>;
+	break;
+    }
+}
+
+
+#ifdef ISA_X86
+void Mchjmeterdsp::select_avx2 (void)
+{
+    switch (_type)
+    {
+    case VU:
+	_proc = &Mchjmeterdsp::process_vu_avx2;
+	break;
+    case IEC1:
+    case IEC2:
+	_proc = &Mchjmeterdsp::process_iec_avx2;
+	break;
+    case KMETER:
+	_proc = &Mchjmeterdsp::process_km_avx2;
+	break;
+    }
+}
+
+
+// The kernels are inlined here, compiled for AVX2.
+void Mchjmeterdsp::process_vu_avx2 (float * const *p, int n)
+{
+    process_vu <v8sf> (p, n);
+}
+
+
+void Mchjmeterdsp::process_iec_avx2 (float * const *p, int n)
+{
+    process_iec <v8sf> (p, n);
+}
+
+
+void Mchjmeterdsp::process_km_avx2 (float * const *p, int n)
+{
+    process_km <v8sf> (p, n);
+}
+#endif
+
+
+void Mchjmeterdsp::reset (void)
+{
+    for (int i = 0; i < _nlane * _ngrp; i++)
+    {
+	_z1 [i] = _z2 [i] = _m [i] = 0;
+    }
+    _k = 0;
+    for (int c = 0; c < _nchan; c++)
+    {
+	_res [c] = (_type != KMETER);
+	_rms [c] = _peak [c] = 0;
+	_cnt [c] = 0;
+    }
+}
+
+
+void Mchjmeterdsp::lanes (float * const *p, int g, const float *q [8]) const
+{
+    // Unused lanes of the last group duplicate its first channel,
+    // their results are never read.
+    for (int l = 0; l < _nlane; l++)
+    {
+	const int c = _nlane * g + l;
+	q [l] = p [c < _nchan ? c : _nlane * g];
+    }
+}
+
+
+bool Mchjmeterdsp::silent (float * const *p, int g, int i, int n) const
+{
+    for (int c = _nlane * g; c < _nlane * (g + 1) && c < _nchan; c++)
+    {
+	if (!v4_silent (p [c] + i, n, silence_floor)) return false;
+    }
+    return true;
+}
+
+
+static inline double damped (double r, double th, double a, double b, double g)
+{
+    // r^g * (a * cos (g th) + b * sin (g th))
+    return pow (r, g) * (a * cos (g * th) + b * sin (g * th));
+}
+
+
+void Mchjmeterdsp::vu_decay (float &z1, float &z2, float &m, int ng) const
+{
+    // For a 2x2 matrix M with eigenvalues r * exp (+-j th),
+    // M^g = r^g * (cos (g th) I + sin (g th) / sin (th) * (M / r - cos (th) I)).
+    const double r = exp (_vlr);
+    const double c = cos (_vth);
+    const double s = sin (_vth);
+    const double u1 = ((_vm [0][0] * z1 + _vm [0][1] * z2) / r - c * z1) / s;
+    const double u2 = ((_vm [1][0] * z1 + _vm [1][1] * z2) / r - c * z2) / s;
+    float v;
+
+    // Max of z2 over groups 1 to ng: the end points, and the integers
+    // around each extremum. These are spaced by half a period.
+    v = (float) damped (r, _vth, z2, u2, 1);
+    if (v > m) m = v;
+    v = (float) damped (r, _vth, z2, u2, ng);
+    if (v > m) m = v;
+    const double hp = M_PI / _vth;
+    double x = atan2 (-(z2 * _vlr + u2 * _vth), u2 * _vlr - z2 * _vth) / _vth;
+    x -= hp * floor ((x - 1) / hp);
+    for (; x < ng; x += hp)
+    {
+	v = (float) damped (r, _vth, z2, u2, floor (x));
+	if (v > m) m = v;
+	v = (float) damped (r, _vth, z2, u2, ceil (x));
+	if (v > m) m = v;
+    }
+
+    z1 = (float) damped (r, _vth, z1, u1, ng);
+    z2 = (float) damped (r, _vth, z2, u2, ng);
+}
+
+
+template <typename V>
+void Mchjmeterdsp::process_vu (float * const *p, int n)
+{
+    typedef Lanes <V> L;
+    const V w  = L::set1 (_w1);
+    const V w4 = L::set1 (4 * _w1);
+    const V h  = L::set1 (0.5f);
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	const float *q [8];
+	float z [L::N], s [L::N], m [L::N];
+	V    z1, z2, vm, t1, t2;
+	int  i, j, k;
+
+	lanes (p, g, q);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    z [k] = _z1 [c] > 20 ? 20 : (_z1 [c] < -20 ? -20 : _z1 [c]);
+	    s [k] = _z2 [c] > 20 ? 20 : (_z2 [c] < -20 ? -20 : _z2 [c]);
+	    m [k] = (c < _nchan && _res [c]) ? 0 : _m [c];
+	    if (c < _nchan) _res [c] = false;
+	}
+	z1 = L::load (z);
+	z2 = L::load (s);
+	vm = L::load (m);
+
+	// Complete the group of four left open by the previous cycle.
+	t2 = z2 * h;
+	for (i = 0, j = _k; j && i < n; i++)
+	{
+	    t1 = L::abs (L::gather (q, i)) - t2;
+	    z1 += w * (t1 - z1);
+	    if (++j == 4)
+	    {
+		z2 += w4 * (z1 - z2);
+		vm = L::max (z2, vm);
+		j = 0;
+	    }
+	}
+
+	k = (n - i) / 4;
+	if (k > 1 && _vth > 0 && silent (p, g, i, 4 * k))
+	{
+	    L::store (z, z1);
+	    L::store (s, z2);
+	    L::store (m, vm);
+	    for (j = 0; j < L::N; j++) vu_decay (z [j], s [j], m [j], k);
+	    z1 = L::load (z);
+	    z2 = L::load (s);
+	    vm = L::load (m);
+	    i += 4 * k;
+	}
+
+	for (; i + 4 <= n; i += 4)
+	{
+	    t2 = z2 * h;
+	    for (k = 0; k < 4; k++)
+	    {
+		t1 = L::abs (L::gather (q, i + k)) - t2;
+		z1 += w * (t1 - z1);
+	    }
+	    z2 += w4 * (z1 - z2);
+	    vm = L::max (z2, vm);
+	}
+
+	// Start a new group with the remaining samples.
+	if (i < n)
+	{
+	    t2 = z2 * h;
+	    for (; i < n; i++)
+	    {
+		t1 = L::abs (L::gather (q, i)) - t2;
+		z1 += w * (t1 - z1);
+	    }
+	}
+
+	L::store (z, z1);
+	L::store (s, z2);
+	L::store (m, vm);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    if (!isfinite (z [k])) { _z1 [c] = 0; m [k] = INFINITY; } else _z1 [c] = z [k];
+	    if (!isfinite (s [k])) { _z2 [c] = 0; m [k] = INFINITY; } else _z2 [c] = s [k];
+	    _m [c] = m [k];
+	}
+    }
+    _k = (_k + n) & 3;
+}
+
+
+template <typename V>
+void Mchjmeterdsp::process_iec (float * const *p, int n)
+{
+    typedef Lanes <V> L;
+    const V w1 = L::set1 (_w1);
+    const V w2 = L::set1 (_w2);
+    const V w3 = L::set1 (_w3);
+    const V zero = L::set1 (0);
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	const float *q [8];
+	float z [L::N], s [L::N], m [L::N];
+	V    z1, z2, vm, t;
+	int  i, j, k;
+
+	lanes (p, g, q);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    z [k] = _z1 [c] > 20 ? 20 : (_z1 [c] < 0 ? 0 : _z1 [c]);
+	    s [k] = _z2 [c] > 20 ? 20 : (_z2 [c] < 0 ? 0 : _z2 [c]);
+	    m [k] = (c < _nchan && _res [c]) ? 0 : _m [c];
+	    if (c < _nchan) _res [c] = false;
+	}
+	z1 = L::load (z);
+	z2 = L::load (s);
+	vm = L::load (m);
+
+	// Complete the group of four left open by the previous cycle.
+	for (i = 0, j = _k; j && i < n; i++)
+	{
+	    t = L::abs (L::gather (q, i));
+	    z1 += w1 * L::max (t - z1, zero);
+	    z2 += w2 * L::max (t - z2, zero);
+	    if (++j == 4)
+	    {
+		vm = L::max (z1 + z2, vm);
+		j = 0;
+	    }
+	}
+
+	// Silence: the release only, the maximum is at the end of the first group.
+	k = (n - i) / 4;
+	if (k > 1 && silent (p, g, i, 4 * k))
+	{
+	    const V d = L::set1 ((float) pow (_w3, k - 1));
+	    z1 *= w3;
+	    z2 *= w3;
+	    vm = L::max (z1 + z2, vm);
+	    z1 *= d;
+	    z2 *= d;
+	    i += 4 * k;
+	}
+
+	for (; i + 4 <= n; i += 4)
+	{
+	    z1 *= w3;
+	    z2 *= w3;
+	    for (k = 0; k < 4; k++)
+	    {
+		t = L::abs (L::gather (q, i + k));
+		z1 += w1 * L::max (t - z1, zero);
+		z2 += w2 * L::max (t - z2, zero);
+	    }
+	    vm = L::max (z1 + z2, vm);
+	}
+
+	// Start a new group with the remaining samples.
+	if (i < n)
+	{
+	    z1 *= w3;
+	    z2 *= w3;
+	    for (; i < n; i++)
+	    {
+		t = L::abs (L::gather (q, i));
+		z1 += w1 * L::max (t - z1, zero);
+		z2 += w2 * L::max (t - z2, zero);
+	    }
+	}
+
+	L::store (z, z1);
+	L::store (s, z2);
+	L::store (m, vm);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    _z1 [c] = z [k];
+	    _z2 [c] = s [k];
+	    _m [c] = m [k];
+	}
+    }
+    _k = (_k + n) & 3;
+}
+
+
+template <typename V>
+void Mchjmeterdsp::process_km (float * const *p, int n)
+{
+    typedef Lanes <V> L;
+    const V w  = L::set1 (_w1);
+    const V w4 = L::set1 (4 * _w1);
+    const V d4 = L::set1 (_d4);
+    const V c0 = L::set1 (_c [0]);
+    const V c1 = L::set1 (_c [1]);
+    const V c2 = L::set1 (_c [2]);
+    const V c3 = L::set1 (_c [3]);
+
+    if (_fpp != n)
+    {
+	const float fall = 15.0f;
+	const float tme = (float) n / _fsamp; // period time in seconds
+	_fall = powf (10.0f, -0.05f * fall * tme); // per period fallback multiplier
+	_fpp = n;
+    }
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	const float *q [8];
+	float z [L::N], s [L::N], m [L::N];
+	V    z1, z2, vt, x, x0, x1, x2, x3;
+	int  i, j, k;
+
+	lanes (p, g, q);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    z [k] = _z1 [c] > 50 ? 50 : (_z1 [c] < 0 ? 0 : _z1 [c]);
+	    s [k] = _z2 [c] > 50 ? 50 : (_z2 [c] < 0 ? 0 : _z2 [c]);
+	}
+	z1 = L::load (z);
+	z2 = L::load (s);
+	vt = L::set1 (0);
+
+	// Complete the group of four left open by the previous cycle.
+	for (i = 0, j = _k; j && i < n; i++)
+	{
+	    x = L::gather (q, i);
+	    x *= x;
+	    vt = L::max (x, vt);
+	    z1 += w * (x - z1);
+	    if (++j == 4)
+	    {
+		z2 += w4 * (z1 - z2);
+		j = 0;
+	    }
+	}
+
+	// Silence: z1 decays by a = 1 - d4 per group, and after k groups
+	// z2 = b^k * z2 + w4 * z1 * sum (b^(k-j) * a^j), j = 1..k with b = 1 - w4.
+	k = (n - i) / 4;
+	if (k > 1 && silent (p, g, i, 4 * k))
+	{
+	    const double a = 1.0 - _d4;
+	    const double b = 1.0 - 4 * _w1;
+	    const double ak = pow (a, k);
+	    const double bk = pow (b, k);
+	    const double sk = (a != b) ? a * (ak - bk) / (a - b) : k * ak;
+	    z2 = z2 * L::set1 ((float) bk) + L::set1 ((float)(4 * _w1 * sk)) * z1;
+	    z1 *= L::set1 ((float) ak);
+	    i += 4 * k;
+	}
+
+	// Only z1 at the end of each group is used, the four terms of
+	// the first filter are independent.
+	for (; i + 4 <= n; i += 4)
+	{
+	    x0 = L::gather (q, i);
+	    x1 = L::gather (q, i + 1);
+	    x2 = L::gather (q, i + 2);
+	    x3 = L::gather (q, i + 3);
+	    x0 *= x0;
+	    x1 *= x1;
+	    x2 *= x2;
+	    x3 *= x3;
+	    vt = L::max (x0, vt);         // Update digital peak.
+	    vt = L::max (x1, vt);
+	    vt = L::max (x2, vt);
+	    vt = L::max (x3, vt);
+	    z1 += ((c0 * x0 + c1 * x1) + (c2 * x2 + c3 * x3)) - d4 * z1; // Update first filter.
+	    z2 += w4 * (z1 - z2);         // Update second filter.
+	}
+
+	// The second filter of a group not completed in this cycle
+	// is updated at the start of the next one.
+	if (i < n)
+	{
+	    for (; i < n; i++)
+	    {
+		x = L::gather (q, i);
+		x *= x;
+		vt = L::max (x, vt);
+		z1 += w * (x - z1);
+	    }
+	}
+
+	L::store (z, z1);
+	L::store (s, z2);
+	L::store (m, vt);
+	for (k = 0; k < L::N && L::N * g + k < _nchan; k++)
+	{
+	    const int c = L::N * g + k;
+	    float r, t;
+
+	    if (isnan (z [k])) z [k] = 0;
+	    if (isnan (s [k])) s [k] = 0;
+	    if (!isfinite (m [k])) m [k] = 0;
+
+	    // Save filter state.
+	    _z1 [c] = z [k];
+	    _z2 [c] = s [k];
+
+	    r = sqrtf (2.0f * s [k]);
+	    t = sqrtf (m [k]);
+
+	    if (_res [c]) // Display thread has read the rms value.
+	    {
+		_rms [c] = r;
+		_res [c] = false;
+	    }
+	    else if (r > _rms [c]) _rms [c] = r;
+
+	    // Digital peak hold and fallback.
+	    if (t >= _peak [c])
+	    {
+		_peak [c] = t;
+		_cnt [c] = _hold;
+	    }
+	    else if (_cnt [c] > 0)
+	    {
+		_cnt [c] -= _fpp;
+	    }
+	    else
+	    {
+		_peak [c] *= _fall;
+		_peak [c] += 1e-10f;
+	    }
+	}
+    }
+    _k = (_k + n) & 3;
+}
+
+
+// Eight lane kernels, compiled for AVX2, see cpuisa.h.
+#if defined (ISA_X86) && !defined (__clang__)
+#pragma GCC push_options
+#pragma GCC target ("avx2")
+template void Mchjmeterdsp::process_vu <v8sf> (float * const *p, int n);
+template void Mchjmeterdsp::process_iec <v8sf> (float * const *p, int n);
+template void Mchjmeterdsp::process_km <v8sf> (float * const *p, int n);
+#pragma GCC pop_options
+#endif
+
+
+float Mchjmeterdsp::read (int c)
+{
+    _res [c] = true;
+    if (_type == KMETER) return _rms [c];
+    return _g * _m [c];
+}
+
+
+void Mchjmeterdsp::read (int c, float &rms, float &peak)
+{
+    rms  = _rms [c];
+    peak = _peak [c];
+    _res [c] = true; // Resets _rms in next process().
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
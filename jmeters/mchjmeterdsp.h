@@ -0,0 +1,122 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#ifndef __MCHJMETERDSP_H
+#define	__MCHJMETERDSP_H
+
+#include "cpuisa.h"
+
+namespace LV2M {
+
+// VU, IEC type I and II PPM and K-meter ballistics for any number of
+// channels. It replaces the former per-channel Vumeterdsp, Iec1ppmdsp
+// and Iec2ppmdsp classes. Filter state of four channels is kept in the
+// lanes of one vector, so a stereo bus is a single pass and an 8 channel
+// surround bus two passes over the input.
+//
+// The kernels are templates on the lane type; init() selects a plain
+// float kernel for mono, a two lane kernel for stereo and groups of four
+// lanes for larger channel counts, eight lanes with AVX2. process() makes
+// one indirect call per cycle, the per-sample loops are fully inlined and
+// unrolled.
+//
+// Readings are bit-identical to those scalar classes, and to Kmeterdsp
+// for the K-meter (tools/test_blocksize). The conditional
+// attack 'if (t > z) z += w * (t - z)' is evaluated as
+// 'z += w * max (t - z, 0)', which adds an exact zero when the
+// condition is false.
+//
+// Silent input (below silence_floor) is not filtered, the state is
+// advanced over all complete groups of four samples at once using the
+// closed form of the decay.
+
+class Mchjmeterdsp
+{
+public:
+
+    enum Type { VU, IEC1, IEC2, KMETER };
+
+    Mchjmeterdsp (void);
+    ~Mchjmeterdsp (void);
+
+    void  init (int type, int nchan, float fsamp);
+    void  process (float * const *p, int n) { (this->*_proc) (p, n); }
+    float read (int c);
+    void  read (int c, float &rms, float &peak);
+    void  reset (void);
+
+    int   type (void) const { return _type; }
+    int   nchan (void) const { return _nchan; }
+
+private:
+
+    template <typename V> void select_kernel (void);
+#ifdef ISA_X86
+    void  select_avx2 (void);
+    ISA_AVX2_TARGET void process_vu_avx2 (float * const *p, int n);
+    ISA_AVX2_TARGET void process_iec_avx2 (float * const *p, int n);
+    ISA_AVX2_TARGET void process_km_avx2 (float * const *p, int n);
+#endif
+    template <typename V> ISA_INLINE void process_vu (float * const *p, int n);
+    template <typename V> ISA_INLINE void process_iec (float * const *p, int n);
+    template <typename V> ISA_INLINE void process_km (float * const *p, int n);
+    void  lanes (float * const *p, int g, const float *q [8]) const;
+    bool  silent (float * const *p, int g, int i, int n) const;
+    void  vu_decay (float &z1, float &z2, float &m, int ng) const;
+
+    int            _type;
+    int            _nchan;       // number of channels
+    int            _nlane;       // channels per register: 1, 2, 4 or 8
+    int            _ngrp;        // number of lane groups
+    float         *_z1;          // filter state [_nlane * _ngrp]
+    float         *_z2;          // filter state [_nlane * _ngrp]
+    float         *_m;           // max value since last read() [_nlane * _ngrp]
+    bool          *_res;         // flag to reset m [_nchan]
+    int            _k;           // samples into the current group of 4
+
+    float          _w1;          // attack / lowpass filter coefficient
+    float          _w2;          // attack filter coefficient
+    float          _w3;          // release filter coefficient
+    float          _g;           // gain factor
+
+    // VU only, silence
+    double         _vm [2][2];   // transition of z1, z2 per group of four samples
+    double         _vlr;         // log of the modulus of its eigenvalues
+    double         _vth;         // angle of its eigenvalues, 0 if real
+
+    // K-meter only
+    float         *_rms;         // max rms value since last read()
+    float         *_peak;        // max peak value since last read()
+    int           *_cnt;         // digital peak hold counter
+    int            _fpp;         // frames per period
+    int            _hold;        // peak hold timeout
+    float          _d4;          // 1 - (1 - _w1)^4
+    float          _c [4];       // _w1 * (1 - _w1)^(3-k)
+    float          _fall;        // peak fallback
+    float          _fsamp;       // sample-rate
+
+    void (Mchjmeterdsp::*_proc) (float * const *p, int n);
+};
+
+};
+
+#endif
@@ -0,0 +1,367 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2013 Robin Gareus <robin@gareus.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#include <string.h>
+#include <math.h>
+#include "simd.h"
+#include "mchtruepeakdsp.h"
+#include "truepeak-table.c"
+
+namespace LV2M {
+
+Mchtruepeakdsp::Mchtruepeakdsp (void) :
+    _nchan (0),
+    _nphs (NPHS),
+    _isa (ISA_GENERIC),
+    _m (0),
+    _p (0),
+    _z1 (0),
+    _z2 (0),
+    _res (0),
+    _hist (0),
+    _bound (0),
+    _lazy (0)
+{
+}
+
+
+Mchtruepeakdsp::~Mchtruepeakdsp (void)
+{
+    delete[] _m;
+    delete[] _p;
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _res;
+    delete[] _hist;
+}
+
+
+void Mchtruepeakdsp::init (int nchan, float fsamp)
+{
+    _nchan = nchan;
+    delete[] _m;
+    delete[] _p;
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _res;
+    delete[] _hist;
+    _m = new float [nchan];
+    _p = new float [nchan];
+    _z1 = new float [nchan];
+    _z2 = new float [nchan];
+    _res = new bool [nchan];
+    _hist = new float [nchan * HSIZ];
+
+    // Use the smallest factor that gives an effective rate of at least
+    // 176.4 kHz: 4x up to 48 kHz, 2x at 88.2 and 96 kHz, none at 176.4 kHz
+    // and above.
+    for (_nphs = 1; _nphs < NPHS && _nphs * fsamp < 176400; _nphs *= 2);
+    _isa = isa_level ();
+
+    // Coefficients of the zita resampler table for a 1:_nphs ratio,
+    // precomputed by tools/gen_tptable.c, with the phases in adjacent
+    // lanes.
+    const float *T = (_nphs == 1) ? tp_ctab_1 : ((_nphs == 2) ? tp_ctab_2 : tp_ctab_4);
+    memset (_c1, 0, sizeof (_c1));
+    memset (_c2, 0, sizeof (_c2));
+    for (int ph = 0; ph < _nphs; ph++)
+    {
+	for (int i = 0; i < HLEN; i++)
+	{
+	    _c1 [i][ph] = T [HLEN * ph + i];
+	    _c2 [i][ph] = T [HLEN * (_nphs - ph) + i];
+	}
+    }
+
+    // Largest gain of any phase, with some headroom for the rounding
+    // of the float sums.
+    _bound = 0;
+    for (int ph = 0; ph < _nphs; ph++)
+    {
+	double s = 0;
+	for (int i = 0; i < HLEN; i++) s += fabs (_c1 [i][ph]) + fabs (_c2 [i][ph]);
+	if (s > _bound) _bound = s;
+    }
+    _bound *= 1.0001f;
+
+    // Ballistics run at the oversampled rate.
+    _w1 = 4000.0f / fsamp / _nphs;
+    _w2 = 17200.0f / fsamp / _nphs;
+    _w3 = 1.0f - 7.0f / fsamp / _nphs;
+    _g = 0.502f;
+
+    // The filter history starts out as silence.
+    memset (_hist, 0, nchan * HSIZ * sizeof (float));
+    for (int c = 0; c < nchan; c++) _z1 [c] = _z2 [c] = 0;
+    reset ();
+}
+
+
+void Mchtruepeakdsp::reset (void)
+{
+    for (int c = 0; c < _nchan; c++)
+    {
+	_res [c] = true;
+	_m [c] = _p [c] = 0;
+    }
+}
+
+
+static float sample_peak (const float *p, int n)
+{
+    v4sf  vm = v4_set1 (0);
+    float m;
+    int   i;
+
+    for (i = 0; i + 4 <= n; i += 4) vm = v4_max (v4_abs (v4_load (p + i)), vm);
+    m = v4_hmax (vm);
+    for (; i < n; i++) if (fabsf (p [i]) > m) m = fabsf (p [i]);
+    return m;
+}
+
+
+template <int N, bool B, typename V>
+void Mchtruepeakdsp::process_grp (float * const *p, int c, int n, float hold)
+{
+    typedef Lanes <V> L;
+
+    const float *w [N];
+    float       *h [N];
+    float        z1 [N], z2 [N], m [N], t [4], v;
+    V            s [N], vp [N];
+    int          i, j, k;
+    bool         skip = false;
+
+    for (k = 0; k < N; k++)
+    {
+	// History: the last NTAP-1 input samples of the previous cycle,
+	// followed by the first NTAP-1 samples of this one.
+	h [k] = _hist + (c + k) * HSIZ;
+	memcpy (h [k] + NTAP - 1, p [c + k], ((n < NTAP - 1) ? n : NTAP - 1) * sizeof (float));
+	vp [k] = L::set1 (_res [c + k] ? 0 : (B ? _p [c + k] : _m [c + k]));
+	m [k] = _res [c + k] ? 0 : _m [c + k];
+	z1 [k] = _z1 [c + k] > 20 ? 20 : (_z1 [c + k] < 0 ? 0 : _z1 [c + k]);
+	z2 [k] = _z2 [c + k] > 20 ? 20 : (_z2 [c + k] < 0 ? 0 : _z2 [c + k]);
+    }
+
+    if (!B && _lazy > 0)
+    {
+	// Skip the filter if no channel of the group can exceed what is
+	// already held. The outputs of this cycle depend on the previous
+	// NTAP-1 input samples as well. The sample peak of the cycle is
+	// still recorded, as a lower bound.
+	float sp [N];
+	for (k = 0; k < N; k++)
+	{
+	    const float l = hold > m [k] ? hold : m [k];
+	    sp [k] = sample_peak (p [c + k], n);
+	    if (sp [k] * _lazy > l) break;
+	    if (sample_peak (h [k], NTAP - 1) * _lazy > l) break;
+	}
+	if (k == N)
+	{
+	    skip = true;
+	    for (k = 0; k < N; k++) vp [k] = L::max (L::set1 (sp [k]), vp [k]);
+	}
+    }
+
+    for (j = skip ? n : 0; j < n; j++)
+    {
+	// NTAP input samples ending with p [j].
+	for (k = 0; k < N; k++)
+	{
+	    w [k] = (j < NTAP - 1) ? h [k] + j : p [c + k] + j - (NTAP - 1);
+	}
+	if (L::N == 1)
+	{
+	    // Without oversampling the filter is the identity,
+	    // delayed by HLEN-1 samples.
+	    for (k = 0; k < N; k++) s [k] = L::abs (L::load (w [k] + HLEN - 1));
+	}
+	else
+	{
+	    for (k = 0; k < N; k++) s [k] = L::set1 (0);
+	    // Same summation order per phase as in Resampler::process.
+	    for (i = 0; i < HLEN; i++)
+	    {
+		const V a = L::load (_c1 [i]);
+		const V b = L::load (_c2 [i]);
+		for (k = 0; k < N; k++)
+		{
+		    s [k] += a * L::set1 (w [k][i]) + b * L::set1 (w [k][NTAP - 1 - i]);
+		}
+	    }
+	    for (k = 0; k < N; k++) s [k] = L::abs (s [k]);
+	}
+	for (k = 0; k < N; k++)
+	{
+	    vp [k] = L::max (s [k], vp [k]);
+	    if (!B) continue;
+
+	    z1 [k] *= _w3;
+	    z2 [k] *= _w3;
+	    L::store (t, s [k]);
+	    for (i = 0; i < L::N; i++)
+	    {
+		v = t [i];
+		if (v > z1 [k]) z1 [k] += _w1 * (v - z1 [k]);
+		if (v > z2 [k]) z2 [k] += _w2 * (v - z2 [k]);
+	    }
+	    v = z1 [k] + z2 [k];
+	    if (v > m [k]) m [k] = v;
+	}
+    }
+
+    for (k = 0; k < N; k++)
+    {
+	const int ch = c + k;
+
+	// Keep the last NTAP-1 input samples for the next cycle.
+	if (n >= NTAP - 1) memcpy (h [k], p [ch] + n - (NTAP - 1), (NTAP - 1) * sizeof (float));
+	else memmove (h [k], h [k] + n, (NTAP - 1) * sizeof (float));
+
+	if (!B)
+	{
+	    _m [ch] = L::hmax (vp [k]);
+	    _res [ch] = false;
+	    continue;
+	}
+
+	_z1 [ch] = z1 [k];
+	_z2 [ch] = z2 [k];
+	m [k] *= _g;
+	v = L::hmax (vp [k]);
+	if (_res [ch])
+	{
+	    _m [ch] = m [k];
+	    _p [ch] = v;
+	    _res [ch] = false;
+	}
+	else
+	{
+	    if (m [k] > _m [ch]) _m [ch] = m [k];
+	    if (v > _p [ch]) _p [ch] = v;
+	}
+    }
+}
+
+
+template <bool B, typename V>
+void Mchtruepeakdsp::process_all (float * const *p, int n, float hold)
+{
+    if (n <= 0) return;
+    for (int c = 0; c < _nchan; c += 4)
+    {
+	switch (_nchan - c)
+	{
+	case 1:  process_grp <1, B, V> (p, c, n, hold); break;
+	case 2:  process_grp <2, B, V> (p, c, n, hold); break;
+	case 3:  process_grp <3, B, V> (p, c, n, hold); break;
+	default: process_grp <4, B, V> (p, c, n, hold); break;
+	}
+    }
+}
+
+
+#ifdef ISA_X86
+template <bool B, typename V>
+void Mchtruepeakdsp::process_avx2 (float * const *p, int n, float hold)
+{
+    process_all <B, V> (p, n, hold);
+}
+#endif
+
+
+void Mchtruepeakdsp::process (float * const *p, int n)
+{
+#ifdef ISA_X86
+    if (_isa >= ISA_AVX2)
+    {
+	switch (_nphs)
+	{
+	case 1:  process_avx2 <true, float> (p, n, 0); break;
+	case 2:  process_avx2 <true, v2sf> (p, n, 0); break;
+	default: process_avx2 <true, v4sf> (p, n, 0); break;
+	}
+	return;
+    }
+#endif
+    switch (_nphs)
+    {
+    case 1:  process_all <true, float> (p, n, 0); break;
+    case 2:  process_all <true, v2sf> (p, n, 0); break;
+    default: process_all <true, v4sf> (p, n, 0); break;
+    }
+}
+
+
+void Mchtruepeakdsp::process_max (float * const *p, int n, float hold)
+{
+#ifdef ISA_X86
+    if (_isa >= ISA_AVX2)
+    {
+	switch (_nphs)
+	{
+	case 1:  process_avx2 <false, float> (p, n, hold); break;
+	case 2:  process_avx2 <false, v2sf> (p, n, hold); break;
+	default: process_avx2 <false, v4sf> (p, n, hold); break;
+	}
+	return;
+    }
+#endif
+    switch (_nphs)
+    {
+    case 1:  process_all <false, float> (p, n, hold); break;
+    case 2:  process_all <false, v2sf> (p, n, hold); break;
+    default: process_all <false, v4sf> (p, n, hold); break;
+    }
+}
+
+
+float Mchtruepeakdsp::read (int c)
+{
+    _res [c] = true;
+    return _m [c];
+}
+
+
+void Mchtruepeakdsp::read (int c, float &m, float &p)
+{
+    _res [c] = true;
+    m = _m [c];
+    p = _p [c];
+}
+
+
+float Mchtruepeakdsp::read_max (void)
+{
+    float m = 0;
+    for (int c = 0; c < _nchan; c++)
+    {
+	if (_m [c] > m) m = _m [c];
+	_res [c] = true;
+    }
+    return m;
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
@@ -0,0 +1,100 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2013 Robin Gareus <robin@gareus.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+#ifndef __MCHTRUEPEAKDSP_H
+#define	__MCHTRUEPEAKDSP_H
+
+#include "cpuisa.h"
+
+namespace LV2M {
+
+// True-peak meter for any number of channels, replacing the former
+// per-channel TruePeakdsp. All channels are oversampled in one pass over
+// the filter table: up to four channels share each coefficient load, the
+// four phases of a channel are the lanes of one vector. The oversampling
+// factor depends on the sample-rate, see init(). Up to 48 kHz readings
+// are bit-identical to TruePeakdsp.
+//
+// For max-hold use process_max() can be made lazy: the true-peak of a
+// cycle is at most bound() times the largest input sample that enters
+// the filter, so when that is below the level already held by the
+// caller the oversampling is skipped and only the filter history is
+// updated. With set_lazy (bound ()) the held maximum is exactly the
+// same as without; a smaller margin trades accuracy for speed.
+
+class Mchtruepeakdsp
+{
+public:
+
+    Mchtruepeakdsp (void);
+    ~Mchtruepeakdsp (void);
+
+    void  init (int nchan, float fsamp);
+    void  process (float * const *p, int n);      // peak and ballistics
+    void  process_max (float * const *p, int n, float hold = 0); // peak only
+    float read (int c);                           // peak, process_max ()
+    void  read (int c, float &m, float &p);       // ballistics and peak, process ()
+    float read_max (void);                        // max of all channels, process_max ()
+    void  reset (void);
+
+    void  set_lazy (float margin) { _lazy = margin; }  // 0: always oversample
+    float bound (void) const { return _bound; }
+    int   factor (void) const { return _nphs; }  // oversampling factor
+
+    int   nchan (void) const { return _nchan; }
+
+private:
+
+    // Up to 4x oversampling polyphase FIR, same filter as
+    // zita Resampler::setup (fsamp, _nphs * fsamp, 1, 24, 1.0).
+    enum { NPHS = 4, HLEN = 24, NTAP = 2 * HLEN, HSIZ = 2 * NTAP - 2 };
+
+    template <int N, bool B, typename V> void process_grp (float * const *p, int c, int n, float hold);
+    template <bool B, typename V> void process_all (float * const *p, int n, float hold);
+#ifdef ISA_X86
+    template <bool B, typename V> ISA_AVX2_TARGET void process_avx2 (float * const *p, int n, float hold);
+#endif
+
+    int            _nchan;       // number of channels
+    int            _nphs;        // oversampling factor: 1, 2 or 4
+    int            _isa;         // kernel variant, see cpuisa.h
+    float         *_m;           // max value since last read() [_nchan]
+    float         *_p;           // peak since last read() [_nchan]
+    float         *_z1;          // filter state [_nchan]
+    float         *_z2;          // filter state [_nchan]
+    bool          *_res;         // flag to reset m and p [_nchan]
+    float         *_hist;        // input history [_nchan * HSIZ]
+
+    float          _c1 [HLEN][NPHS]; // taps for the first half of the window, per phase
+    float          _c2 [HLEN][NPHS]; // taps for the second half, reversed
+
+    float          _w1;          // attack filter coefficient
+    float          _w2;          // attack filter coefficient
+    float          _w3;          // release filter coefficient
+    float          _g;           // gain factor
+    float          _bound;       // max over phases of the sum of abs (taps)
+    float          _lazy;        // process_max() skip margin, 0 if disabled
+};
+
+};
+
+#endif
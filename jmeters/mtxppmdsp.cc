@@ -0,0 +1,272 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+
+#include <math.h>
+#include "fastmath.h"
+#include "mtxppmdsp.h"
+
+namespace LV2M {
+
+Mtxppmdsp::Mtxppmdsp (void) :
+    _type (IEC2),
+    _nout (0),
+    _ninp (0),
+    _nlane (0),
+    _ngrp (0),
+    _a (0),
+    _mv (0),
+    _db (0),
+    _z1 (0),
+    _z2 (0),
+    _m (0),
+    _res (0),
+    _k (0),
+    _proc (0)
+{
+}
+
+
+Mtxppmdsp::~Mtxppmdsp (void)
+{
+    delete[] _a;
+    delete[] _mv;
+    delete[] _db;
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _m;
+    delete[] _res;
+}
+
+
+void Mtxppmdsp::init (int type, int nout, int ninp, float fsamp)
+{
+    int i;
+
+    _type = type;
+    _nout = nout;
+    _ninp = ninp > MAXINP ? MAXINP : ninp;
+
+    switch (nout)
+    {
+    case 1:  _nlane = 1; break;
+    case 2:  _nlane = 2; break;
+    default: _nlane = 4; break;
+    }
+    _ngrp = (nout + _nlane - 1) / _nlane;
+
+    delete[] _a;
+    delete[] _mv;
+    delete[] _db;
+    delete[] _z1;
+    delete[] _z2;
+    delete[] _m;
+    delete[] _res;
+    _a = new float [_ngrp * _ninp * _nlane];
+    _mv = new float [_nlane * _ngrp];
+    _db = new float [_nout];
+    _z1 = new float [_nlane * _ngrp];
+    _z2 = new float [_nlane * _ngrp];
+    _m = new float [_nlane * _ngrp];
+    _res = new bool [_nout];
+
+    // Unused lanes have all coefficients zero.
+    for (i = 0; i < _ngrp * _ninp * _nlane; i++) _a [i] = 0;
+    for (i = 0; i < _nlane * _ngrp; i++) _mv [i] = 1;
+    for (i = 0; i < _nout; i++) _db [i] = 0;
+
+    // Same coefficients as the IEC types of Mchjmeterdsp.
+    switch (_type)
+    {
+    case IEC1:
+	_w1 =  450.0f / fsamp;
+	_w2 = 1300.0f / fsamp;
+	_w3 = 1.0f - 5.4f / fsamp;
+	_g = 0.5108f;
+	break;
+    default:
+	_w1 = 200.0f / fsamp;
+	_w2 = 860.0f / fsamp;
+	_w3 = 1.0f - 4.0f / fsamp;
+	_g = 0.5141f;
+	break;
+    }
+
+    switch (_nlane)
+    {
+    case 1:  select_kernel <float> (); break;
+    case 2:  select_kernel <v2sf> (); break;
+    default: select_kernel <v4sf> (); break;
+    }
+    reset ();
+}
+
+
+template <typename V>
+void Mtxppmdsp::select_kernel (void)
+{
+    // Fully unrolled matrix products for up to four inputs.
+    switch (_ninp)
+    {
+    case 1:  _proc = &Mtxppmdsp::process_mtx <V, 1>; break;
+    case 2:  _proc = &Mtxppmdsp::process_mtx <V, 2>; break;
+    case 3:  _proc = &Mtxppmdsp::process_mtx <V, 3>; break;
+    case 4:  _proc = &Mtxppmdsp::process_mtx <V, 4>; break;
+    default: _proc = &Mtxppmdsp::process_mtx <V, 0>; break;
+    }
+}
+
+
+void Mtxppmdsp::set_coef (int r, int c, float v)
+{
+    if (r < 0 || r >= _nout || c < 0 || c >= _ninp) return;
+    _a [((r / _nlane) * _ninp + c) * _nlane + r % _nlane] = v;
+}
+
+
+void Mtxppmdsp::set_gain (int r, float db)
+{
+    if (r < 0 || r >= _nout || _db [r] == db) return;
+    _db [r] = db;
+    _mv [r] = fast_db_to_coeff (db);
+}
+
+
+void Mtxppmdsp::reset (void)
+{
+    for (int i = 0; i < _nlane * _ngrp; i++)
+    {
+	_z1 [i] = _z2 [i] = _m [i] = 0;
+    }
+    _k = 0;
+    for (int r = 0; r < _nout; r++) _res [r] = true;
+}
+
+
+// Rows of one lane group for sample i, summed in column order.
+// NI is the number of inputs if known at compile time, else 0.
+template <typename V, int NI>
+static inline V mix (const V *a, float * const *p, int ninp, int i)
+{
+    if (NI) ninp = NI;
+    V t = a [0] * Lanes <V>::set1 (p [0][i]);
+    for (int c = 1; c < ninp; c++) t += a [c] * Lanes <V>::set1 (p [c][i]);
+    return t;
+}
+
+
+template <typename V, int NI>
+void Mtxppmdsp::process_mtx (float * const *p, int n)
+{
+    typedef Lanes <V> L;
+    const V w1 = L::set1 (_w1);
+    const V w2 = L::set1 (_w2);
+    const V w3 = L::set1 (_w3);
+    const V zero = L::set1 (0);
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	float z [L::N], s [L::N], m [L::N];
+	V    a [MAXINP], mv, z1, z2, vm, t;
+	int  c, i, j, k;
+
+	for (c = 0; c < _ninp; c++) a [c] = L::load (_a + (g * _ninp + c) * L::N);
+	mv = L::load (_mv + g * L::N);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int r = L::N * g + k;
+	    z [k] = _z1 [r] > 20 ? 20 : (_z1 [r] < 0 ? 0 : _z1 [r]);
+	    s [k] = _z2 [r] > 20 ? 20 : (_z2 [r] < 0 ? 0 : _z2 [r]);
+	    m [k] = (r < _nout && _res [r]) ? 0 : _m [r];
+	    if (r < _nout) _res [r] = false;
+	}
+	z1 = L::load (z);
+	z2 = L::load (s);
+	vm = L::load (m);
+
+	// Complete the group of four left open by the previous cycle.
+	for (i = 0, j = _k; j && i < n; i++)
+	{
+	    t = mv * L::abs (mix <V, NI> (a, p, _ninp, i));
+	    z1 += w1 * L::max (t - z1, zero);
+	    z2 += w2 * L::max (t - z2, zero);
+	    if (++j == 4)
+	    {
+		vm = L::max (z1 + z2, vm);
+		j = 0;
+	    }
+	}
+
+	for (; i + 4 <= n; i += 4)
+	{
+	    z1 *= w3;
+	    z2 *= w3;
+	    for (k = 0; k < 4; k++)
+	    {
+		// Most samples are below both filters, skipping them
+		// breaks the dependency chain of the filter state.
+		t = mv * L::abs (mix <V, NI> (a, p, _ninp, i + k));
+		if (L::any_gt (t, z1) || L::any_gt (t, z2))
+		{
+		    z1 += w1 * L::max (t - z1, zero);
+		    z2 += w2 * L::max (t - z2, zero);
+		}
+	    }
+	    vm = L::max (z1 + z2, vm);
+	}
+
+	// Start a new group with the remaining samples.
+	if (i < n)
+	{
+	    z1 *= w3;
+	    z2 *= w3;
+	    for (; i < n; i++)
+	    {
+		t = mv * L::abs (mix <V, NI> (a, p, _ninp, i));
+		z1 += w1 * L::max (t - z1, zero);
+		z2 += w2 * L::max (t - z2, zero);
+	    }
+	}
+
+	L::store (z, z1);
+	L::store (s, z2);
+	L::store (m, vm);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int r = L::N * g + k;
+	    _z1 [r] = z [k];
+	    _z2 [r] = s [k];
+	    _m [r] = m [k];
+	}
+    }
+    _k = (_k + n) & 3;
+}
+
+
+float Mtxppmdsp::read (int r)
+{
+    _res [r] = true;
+    return _g * _m [r];
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
@@ -0,0 +1,90 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+
+#ifndef __MTXPPMDSP_H
+#define	__MTXPPMDSP_H
+
+namespace LV2M {
+
+// PPM ballistics on linear combinations of the input channels,
+// y [r] = gain [r] * |sum_c coef [r][c] * x [c]|. M/S is the matrix
+// { 1, 1 }, { 1, -1 }; L/C/R downmixes or other sums of a few channels
+// work the same way.
+//
+// All outputs are computed in a single pass over the inputs. The rows
+// are the lanes of a vector, one for up to two outputs and groups of
+// four for more. With coefficients of +1 and -1 readings are
+// bit-identical to Mchjmeterdsp of the same IEC type, fed with the sums
+// of the input channels, except after silence, which only Mchjmeterdsp
+// skips in closed form (tools/test_blocksize).
+
+class Mtxppmdsp
+{
+public:
+
+    enum Type { IEC1, IEC2 };
+    enum { MAXINP = 8 };
+
+    Mtxppmdsp (void);
+    ~Mtxppmdsp (void);
+
+    void  init (int type, int nout, int ninp, float fsamp);
+    void  set_coef (int r, int c, float v);
+    void  set_gain (int r, float db);
+    void  process (float * const *p, int n) { (this->*_proc) (p, n); }
+    float read (int r);
+    void  reset (void);
+
+    int   nout (void) const { return _nout; }
+    int   ninp (void) const { return _ninp; }
+
+private:
+
+    template <typename V> void select_kernel (void);
+    template <typename V, int NI> void process_mtx (float * const *p, int n);
+
+    int            _type;
+    int            _nout;        // number of outputs (matrix rows)
+    int            _ninp;        // number of inputs (matrix columns)
+    int            _nlane;       // rows per register: 1, 2 or 4
+    int            _ngrp;        // number of lane groups
+    float         *_a;           // coefficients [_ngrp][_ninp][_nlane]
+    float         *_mv;          // output gain [_nlane * _ngrp]
+    float         *_db;          // output gain in dB [_nout]
+    float         *_z1;          // filter state [_nlane * _ngrp]
+    float         *_z2;          // filter state [_nlane * _ngrp]
+    float         *_m;           // max value since last read() [_nlane * _ngrp]
+    bool          *_res;         // flag to reset m [_nout]
+    int            _k;           // samples into the current group of 4
+
+    float          _w1;          // attack filter coefficient
+    float          _w2;          // attack filter coefficient
+    float          _w3;          // release filter coefficient
+    float          _g;           // gain factor
+
+    void (Mtxppmdsp::*_proc) (float * const *p, int n);
+};
+
+};
+
+#endif
@@ -0,0 +1,242 @@
+/* meter.lv2 -- 4-lane float vector helpers
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef __JMETER_SIMD_H
+#define	__JMETER_SIMD_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "cpuisa.h"
+
+/* GCC/clang generic vector extensions. These compile to SSE on x86,
+ * NEON on ARM and plain scalar code elsewhere, so no ISA specific
+ * intrinsics are needed here.
+ *
+ * All helpers are element-wise and use the same IEEE operations as the
+ * scalar code they replace; results are bit-identical as long as the
+ * compiler does not contract a*b+c into FMA (not done without -mfma or
+ * -ffp-contract=fast on the targets we build for).
+ */
+
+namespace LV2M {
+
+typedef float   v2sf __attribute__ ((vector_size (8)));
+typedef int32_t v2si __attribute__ ((vector_size (8)));
+typedef float   v4sf __attribute__ ((vector_size (16)));
+typedef int32_t v4si __attribute__ ((vector_size (16)));
+
+static inline v4sf v4_set1 (float v)
+{
+    v4sf r = { v, v, v, v };
+    return r;
+}
+
+static inline v4sf v4_load (const float *p)
+{
+    v4sf r;
+    memcpy (&r, p, sizeof (v4sf));
+    return r;
+}
+
+static inline void v4_store (float *p, v4sf v)
+{
+    memcpy (p, &v, sizeof (v4sf));
+}
+
+/* a if mask is set, else b */
+static inline v4sf v4_select (v4si mask, v4sf a, v4sf b)
+{
+    return (v4sf)(((v4si)a & mask) | ((v4si)b & ~mask));
+}
+
+/* same semantics as 'if (a > b) b = a;' -- NaN in a is ignored */
+static inline v4sf v4_max (v4sf a, v4sf b)
+{
+    return v4_select (a > b, a, b);
+}
+
+static inline v4sf v4_abs (v4sf a)
+{
+    const v4si m = { 0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff };
+    return (v4sf)((v4si)a & m);
+}
+
+static inline float v4_hmax (v4sf a)
+{
+    float m = a[0];
+    if (a[1] > m) m = a[1];
+    if (a[2] > m) m = a[2];
+    if (a[3] > m) m = a[3];
+    return m;
+}
+
+/* pairwise sum, (a0 + a1) + (a2 + a3) */
+static inline float v4_hsum (v4sf a)
+{
+    return (a[0] + a[1]) + (a[2] + a[3]);
+}
+
+/* Silence threshold, -200 dBFS */
+static const float silence_floor = 1e-10f;
+
+/* true if |p [i]| <= thr for all i < n, NaN is never silent.
+ * Returns at the first group of 16 samples above the threshold.
+ */
+static inline bool v4_silent (const float *p, int n, float thr)
+{
+    const v4sf t = v4_set1 (thr);
+    int i;
+    for (i = 0; i + 16 <= n; i += 16)
+    {
+	const v4si k = ~(v4_abs (v4_load (p + i)) <= t)
+		     | ~(v4_abs (v4_load (p + i + 4)) <= t)
+		     | ~(v4_abs (v4_load (p + i + 8)) <= t)
+		     | ~(v4_abs (v4_load (p + i + 12)) <= t);
+	int64_t r [2];
+	memcpy (r, &k, sizeof (r));
+	if (r [0] | r [1]) return false;
+    }
+    for (; i < n; i++)
+    {
+	if (!(fabsf (p [i]) <= thr)) return false;
+    }
+    return true;
+}
+
+/* Lane traits, used to specialize kernels at compile time for
+ * one (plain float), two or four channels per register.
+ */
+template <typename V> struct Lanes;
+
+template <> struct Lanes <float>
+{
+    enum { N = 1 };
+    static float set1 (float v) { return v; }
+    static float load (const float *p) { return *p; }
+    static void  store (float *p, float v) { *p = v; }
+    static float gather (const float * const *q, int i) { return q [0][i]; }
+    static float abs (float a) { return fabsf (a); }
+    static float max (float a, float b) { return a > b ? a : b; }
+    static float hmax (float a) { return a; }
+    static bool  any_gt (float a, float b) { return a > b; }
+};
+
+template <> struct Lanes <v2sf>
+{
+    enum { N = 2 };
+    static v2sf set1 (float v) { v2sf r = { v, v }; return r; }
+    static v2sf load (const float *p) { v2sf r; memcpy (&r, p, sizeof (v2sf)); return r; }
+    static void store (float *p, v2sf v) { memcpy (p, &v, sizeof (v2sf)); }
+    static v2sf gather (const float * const *q, int i) { v2sf r = { q [0][i], q [1][i] }; return r; }
+    static v2sf abs (v2sf a)
+    {
+	const v2si m = { 0x7fffffff, 0x7fffffff };
+	return (v2sf)((v2si)a & m);
+    }
+    static v2sf max (v2sf a, v2sf b)
+    {
+	const v2si k = a > b;
+	return (v2sf)(((v2si)a & k) | ((v2si)b & ~k));
+    }
+    static float hmax (v2sf a) { return a [1] > a [0] ? a [1] : a [0]; }
+    static bool  any_gt (v2sf a, v2sf b)
+    {
+	const v2si k = a > b;
+	int64_t r;
+	memcpy (&r, &k, sizeof (r));
+	return r != 0;
+    }
+};
+
+template <> struct Lanes <v4sf>
+{
+    enum { N = 4 };
+    static v4sf set1 (float v) { return v4_set1 (v); }
+    static v4sf load (const float *p) { return v4_load (p); }
+    static void store (float *p, v4sf v) { v4_store (p, v); }
+    static v4sf gather (const float * const *q, int i)
+    {
+	v4sf r = { q [0][i], q [1][i], q [2][i], q [3][i] };
+	return r;
+    }
+    static v4sf abs (v4sf a) { return v4_abs (a); }
+    static v4sf max (v4sf a, v4sf b) { return v4_max (a, b); }
+    static float hmax (v4sf a) { return v4_hmax (a); }
+    static bool  any_gt (v4sf a, v4sf b)
+    {
+	const v4si k = a > b;
+	int64_t r [2];
+	memcpy (r, &k, sizeof (r));
+	return (r [0] | r [1]) != 0;
+    }
+};
+
+#ifdef ISA_X86
+/* Eight lanes, for the AVX2 kernel variants only (see cpuisa.h). The
+ * helpers are compiled for AVX2 and must only be called from code that
+ * is compiled for AVX2 as well, that is from ISA_INLINE kernels inlined
+ * into an ISA_AVX2_TARGET wrapper.
+ */
+typedef float   v8sf __attribute__ ((vector_size (32)));
+typedef int32_t v8si __attribute__ ((vector_size (32)));
+
+#define LANES_AVX2 __attribute__ ((target ("avx2")))
+
+template <> struct Lanes <v8sf>
+{
+    enum { N = 8 };
+    LANES_AVX2 static v8sf set1 (float v) { v8sf r = { v, v, v, v, v, v, v, v }; return r; }
+    LANES_AVX2 static v8sf load (const float *p) { v8sf r; memcpy (&r, p, sizeof (v8sf)); return r; }
+    LANES_AVX2 static void store (float *p, v8sf v) { memcpy (p, &v, sizeof (v8sf)); }
+    LANES_AVX2 static v8sf gather (const float * const *q, int i)
+    {
+	v8sf r = { q [0][i], q [1][i], q [2][i], q [3][i], q [4][i], q [5][i], q [6][i], q [7][i] };
+	return r;
+    }
+    LANES_AVX2 static v8sf abs (v8sf a)
+    {
+	const v8si m = { 0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff,
+			 0x7fffffff, 0x7fffffff, 0x7fffffff, 0x7fffffff };
+	return (v8sf)((v8si)a & m);
+    }
+    LANES_AVX2 static v8sf max (v8sf a, v8sf b)
+    {
+	const v8si k = a > b;
+	return (v8sf)(((v8si)a & k) | ((v8si)b & ~k));
+    }
+    LANES_AVX2 static float hmax (v8sf a)
+    {
+	float m = a [0];
+	for (int i = 1; i < 8; i++) if (a [i] > m) m = a [i];
+	return m;
+    }
+    LANES_AVX2 static bool any_gt (v8sf a, v8sf b)
+    {
+	const v8si k = a > b;
+	int64_t r [4];
+	memcpy (r, &k, sizeof (r));
+	return (r [0] | r [1] | r [2] | r [3]) != 0;
+    }
+};
+#endif
+
+};
+
+#endif
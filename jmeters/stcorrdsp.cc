@@ -20,22 +20,23 @@
 
 
 #include <math.h>
+#include "simd.h"
 #include "stcorrdsp.h"
 
 namespace LV2M {
 
-float  Stcorrdsp::_w1;
-float  Stcorrdsp::_w2; 
-
-
 
 Stcorrdsp::Stcorrdsp (void) :
     _zl (0),
     _zr (0),
-    _zlr (0),
-    _zll (0),
-    _zrr (0)
+    _cmin (1.0f),
+    _w1 (0)
 {
+    for (int k = 0; k < NTC; k++)
+    {
+	_zlr [k] = _zll [k] = _zrr [k] = 0;
+	_w2 [k] = _d2 [k] = 0;
+    }
 }
 
 
@@ -46,50 +47,159 @@ Stcorrdsp::~Stcorrdsp (void)
 
 void Stcorrdsp::process (float *pl, float *pr, int n)
 {
-    float zl, zr, zlr, zll, zrr;
+    float zl, zr, zlr [NTC], zll [NTC], zrr [NTC];
+    v4sf  xl, xr, yl, yr, m4 [NTC];
+    int   i, k;
+
+    const v4sf d1 = v4_load (_d1);
+    const v4sf m0 = v4_load (_m1 [0]);
+    const v4sf m1 = v4_load (_m1 [1]);
+    const v4sf m2 = v4_load (_m1 [2]);
+    const v4sf m3 = v4_load (_m1 [3]);
 
     zl = _zl;
     zr = _zr;
-    zlr = _zlr;
-    zll = _zll;
-    zrr = _zrr;
+    for (k = 0; k < NTC; k++)
+    {
+	m4 [k] = v4_load (_m2 [k]);
+	zlr [k] = _zlr [k];
+	zll [k] = _zll [k];
+	zrr [k] = _zrr [k];
+    }
+
+    // Silence: the lowpass states decay by a = 1 - _d1 [3] per group
+    // of four samples. The correlation filters decay by b = 1 - _d2 and
+    // are driven by products of the lowpass outputs, c * a^(2g) * zl * zr
+    // in group g, summed over i groups in closed form.
+    i = n / 4;
+    if (i > 1 && v4_silent (pl, 4 * i, silence_floor) && v4_silent (pr, 4 * i, silence_floor))
+    {
+	const double a = 1.0 - _d1 [3];
+	const double am = pow (a, i);
+	for (k = 0; k < NTC; k++)
+	{
+	    const double b = 1.0 - _d2 [k];
+	    const double bm = pow (b, i);
+	    double c = 0;
+	    for (int j = 0; j < 4; j++) c += _m2 [k][j] * (1.0 - _d1 [j]) * (1.0 - _d1 [j]);
+	    c *= (a * a != b) ? (bm - am * am) / (b - a * a) : i * bm / b;
+	    zlr [k] = (float)(bm * zlr [k] + c * zl * zr);
+	    zll [k] = (float)(bm * zll [k] + c * zl * zl);
+	    zrr [k] = (float)(bm * zrr [k] + c * zr * zr);
+	}
+	zl = (float)(am * zl);
+	zr = (float)(am * zr);
+	pl += 4 * i;
+	pr += 4 * i;
+	n -= 4 * i;
+    }
+
+    // Four samples at a time. The lowpass outputs of the group are
+    // computed directly from the state before it, and the correlation
+    // filters only need their state at the end of the group. This
+    // replaces the serial chain of four updates by a single one.
+    for (i = n / 4; i; i--)
+    {
+	xl = v4_load (pl);
+	xr = v4_load (pr);
+	pl += 4;
+	pr += 4;
+	yl = v4_set1 (zl);
+	yr = v4_set1 (zr);
+	yl += (m0 * v4_set1 (xl [0]) + m1 * v4_set1 (xl [1]))
+	    + (m2 * v4_set1 (xl [2]) + m3 * v4_set1 (xl [3])) - d1 * yl;
+	yr += (m0 * v4_set1 (xr [0]) + m1 * v4_set1 (xr [1]))
+	    + (m2 * v4_set1 (xr [2]) + m3 * v4_set1 (xr [3])) - d1 * yr;
+	for (k = 0; k < NTC; k++)
+	{
+	    zlr [k] += v4_hsum (m4 [k] * yl * yr) - _d2 [k] * zlr [k];
+	    zll [k] += v4_hsum (m4 [k] * yl * yl) - _d2 [k] * zll [k];
+	    zrr [k] += v4_hsum (m4 [k] * yr * yr) - _d2 [k] * zrr [k];
+	}
+	zl = yl [3];
+	zr = yr [3];
+    }
+
+    n &= 3;
     while (n--)
     {
-	zl += _w1 * (*pl++ - zl) + 1e-20f;
-	zr += _w1 * (*pr++ - zr) + 1e-20f;
-	zlr += _w2 * (zl * zr - zlr);
-	zll += _w2 * (zl * zl - zll);
-	zrr += _w2 * (zr * zr - zrr);
+	zl += _w1 * (*pl++ - zl);
+	zr += _w1 * (*pr++ - zr);
+	for (k = 0; k < NTC; k++)
+	{
+	    zlr [k] += _w2 [k] * (zl * zr - zlr [k]);
+	    zll [k] += _w2 [k] * (zl * zl - zll [k]);
+	    zrr [k] += _w2 [k] * (zr * zr - zrr [k]);
+	}
     }
 
     if (!isfinite(zl)) zl = 0;
     if (!isfinite(zr)) zr = 0;
-    if (!isfinite(zlr)) zlr = 0;
-    if (!isfinite(zll)) zll = 0;
-    if (!isfinite(zrr)) zrr = 0;
 
     _zl = zl;
     _zr = zr;
-    _zlr = zlr + 1e-10f;
-    _zll = zll + 1e-10f;
-    _zrr = zrr + 1e-10f;
+    for (k = 0; k < NTC; k++)
+    {
+	if (!isfinite(zlr [k])) zlr [k] = 0;
+	if (!isfinite(zll [k])) zll [k] = 0;
+	if (!isfinite(zrr [k])) zrr [k] = 0;
+	_zlr [k] = zlr [k];
+	_zll [k] = zll [k];
+	_zrr [k] = zrr [k];
+    }
+
+    // -60dB on both inputs
+    if (_zll [MAIN] > 1e-6f && _zrr [MAIN] > 1e-6f)
+    {
+	const float c = read (MAIN);
+	if (c < _cmin) _cmin = c;
+    }
 }
 
 
-float Stcorrdsp::read (void)
+float Stcorrdsp::read (int k)
 {
-    return _zlr / sqrtf (_zll * _zrr + 1e-10f);
+    return _zlr [k] / sqrtf (_zll [k] * _zrr [k] + 1e-10f);
 }
 
 
-void Stcorrdsp::init (int fsamp, float flp, float tcf)
+void Stcorrdsp::init (int fsamp, float flp, float tcf, float tcfast, float tcslow)
 {
-    // fsamp = sample frequency
-    // flp   = lowpass frequency
-    // tcf   = correlation filter time constant
+    // fsamp  = sample frequency
+    // flp    = lowpass frequency
+    // tcf    = correlation filter time constant
+    // tcfast = time constant of the fast correlation filter
+    // tcslow = time constant of the slow correlation filter
+
+    const float tc [NTC] = { tcf, tcfast, tcslow };
 
     _w1 = 6.28f * flp / fsamp;
-    _w2 = 1 / (tcf * fsamp);
+
+    // Coefficients for groups of four samples, with a = 1 - _w1:
+    // zl [k] = zl - (1 - a^(k+1)) * zl + sum (_w1 * a^(k-j) * xl [j]), j <= k.
+    // Input weights are normalized to unity DC gain with the rounded
+    // decay terms, which are kept as 1 - a^k for a precise time constant.
+    const double a = 1.0 - _w1;
+    for (int k = 0; k < 4; k++)
+    {
+	const double d = 1.0 - pow (a, k + 1);
+	_d1 [k] = (float) d;
+	for (int j = 0; j < 4; j++)
+	{
+	    _m1 [j][k] = (j <= k) ? (float)(_d1 [k] / d * _w1 * pow (a, k - j)) : 0.0f;
+	}
+    }
+    for (int t = 0; t < NTC; t++)
+    {
+	_w2 [t] = 1 / (tc [t] * fsamp);
+	const double b = 1.0 - _w2 [t];
+	_d2 [t] = (float)(1.0 - pow (b, 4));
+	for (int k = 0; k < 4; k++)
+	{
+	    _m2 [t][k] = (float)(_d2 [t] / (1.0 - pow (b, 4)) * _w2 [t] * pow (b, 3 - k));
+	}
+    }
+    _cmin = 1.0f;
 }
 
 }
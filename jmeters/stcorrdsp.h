@@ -24,28 +24,45 @@
 
 namespace LV2M {
 
+// The lowpass filtered inputs feed NTC sets of correlation filters
+// with different time constants: the main one given to init (), and
+// a fast and a slow one. The minimum of the main reading is tracked
+// while both inputs are above -60dB, until reset_min ().
+
 class Stcorrdsp
 {
 public:
 
+    enum { MAIN, FAST, SLOW, NTC };
+
     Stcorrdsp (void);
     ~Stcorrdsp (void);
 
     void process (float *pl, float *pr, int n);  
-    float read (void);
+    float read (void) { return read (MAIN); }
+    float read (int k);
+    float read_min (void) { return _cmin; }
+    void reset_min (void) { _cmin = 1.0f; }
 
-    static void init (int fsamp, float flp, float tcf); 
+    void init (int fsamp, float flp, float tcf, float tcfast = 0.05f, float tcslow = 3.0f); 
 
 private:
 
     float          _zl;          // filter states
     float          _zr;
-    float          _zlr;
-    float          _zll;
-    float          _zrr;
+    float          _zlr [NTC];
+    float          _zll [NTC];
+    float          _zrr [NTC];
+    float          _cmin;        // minimum of read (MAIN)
+
+    float          _w1;          // lowpass filter coefficient
+    float          _w2 [NTC];    // correlation filter coeffients
 
-    static float   _w1;          // lowpass filter coefficient
-    static float   _w2;          // correlation filter coeffient
+    // The same filters evaluated four samples at a time.
+    float          _d1 [4];      // 1 - (1 - _w1)^(k+1)
+    float          _m1 [4][4];   // lowpass input weights [j][k]
+    float          _d2 [NTC];    // 1 - (1 - _w2)^4
+    float          _m2 [NTC][4]; // correlation filter input weights
 };
 
 };
@@ -0,0 +1,72 @@
+/* generated by tools/gen_tptable.c -- do not edit */
+
+/* 24 taps per phase, (np + 1) phases, as Resampler_table::_ctab */
+static const float tp_ctab_1 [48] = {
+	2.86455845e-20, -2.12118913e-19, -6.07339852e-20, -3.50340328e-19,
+	1.70862955e-18, -1.18686118e-18, -1.36586596e-18, -2.96261064e-18,
+	1.26534910e-17, -6.00831199e-18, -9.92271056e-18, -1.04471009e-17,
+	4.78129783e-17, -1.60975237e-17, 1.92303577e-17, -2.24534703e-17,
+	2.56639154e-17, -2.87510974e-17, 3.16024651e-17, -3.41094973e-17,
+	3.61736372e-17, -3.77117663e-17, 3.86608932e-17, 1.00000000e+00,
+	-0.00000000e+00, 2.86455845e-20, -2.12118913e-19, -6.07339852e-20,
+	-3.50340328e-19, 1.70862955e-18, -1.18686118e-18, -1.36586596e-18,
+	-2.96261064e-18, 1.26534910e-17, -6.00831199e-18, -9.92271056e-18,
+	-1.04471009e-17, 4.78129783e-17, -1.60975237e-17, 1.92303577e-17,
+	-2.24534703e-17, 2.56639154e-17, -2.87510974e-17, 3.16024651e-17,
+	-3.41094973e-17, 3.61736372e-17, -3.77117663e-17, 3.86608932e-17,
+};
+
+static const float tp_ctab_2 [72] = {
+	2.86455845e-20, -2.12118913e-19, -6.07339852e-20, -3.50340328e-19,
+	1.70862955e-18, -1.18686118e-18, -1.36586596e-18, -2.96261064e-18,
+	1.26534910e-17, -6.00831199e-18, -9.92271056e-18, -1.04471009e-17,
+	4.78129783e-17, -1.60975237e-17, 1.92303577e-17, -2.24534703e-17,
+	2.56639154e-17, -2.87510974e-17, 3.16024651e-17, -3.41094973e-17,
+	3.61736372e-17, -3.77117663e-17, 3.86608932e-17, 1.00000000e+00,
+	-1.05844538e-06, 1.09977564e-05, -3.79591620e-05, 9.59580866e-05,
+	-2.06598983e-04, 3.99541430e-04, -7.12760491e-04, 1.19267055e-03,
+	-1.89423806e-03, 2.88128131e-03, -4.22726898e-03, 6.01709681e-03,
+	-8.35062377e-03, 1.13492673e-02, -1.51679935e-02, 2.00171247e-02,
+	-2.62030084e-02, 3.42076309e-02, -4.48562838e-02, 5.97097054e-02,
+	-8.21287408e-02, 1.20893337e-01, -2.08294064e-01, 6.35306478e-01,
+	-0.00000000e+00, 2.86455845e-20, -2.12118913e-19, -6.07339852e-20,
+	-3.50340328e-19, 1.70862955e-18, -1.18686118e-18, -1.36586596e-18,
+	-2.96261064e-18, 1.26534910e-17, -6.00831199e-18, -9.92271056e-18,
+	-1.04471009e-17, 4.78129783e-17, -1.60975237e-17, 1.92303577e-17,
+	-2.24534703e-17, 2.56639154e-17, -2.87510974e-17, 3.16024651e-17,
+	-3.41094973e-17, 3.61736372e-17, -3.77117663e-17, 3.86608932e-17,
+};
+
+static const float tp_ctab_4 [120] = {
+	2.86455845e-20, -2.12118913e-19, -6.07339852e-20, -3.50340328e-19,
+	1.70862955e-18, -1.18686118e-18, -1.36586596e-18, -2.96261064e-18,
+	1.26534910e-17, -6.00831199e-18, -9.92271056e-18, -1.04471009e-17,
+	4.78129783e-17, -1.60975237e-17, 1.92303577e-17, -2.24534703e-17,
+	2.56639154e-17, -2.87510974e-17, 3.16024651e-17, -3.41094973e-17,
+	3.61736372e-17, -3.77117663e-17, 3.86608932e-17, 1.00000000e+00,
+	-1.73024523e-06, 1.11148438e-05, -3.45345907e-05, 8.32016158e-05,
+	-1.73791865e-04, 3.28735419e-04, -5.76370512e-04, 9.51019174e-04,
+	-1.49308413e-03, 2.24932469e-03, -3.27355647e-03, 4.62815538e-03,
+	-6.38699345e-03, 8.64086021e-03, -1.15072979e-02, 1.51485642e-02,
+	-1.98054649e-02, 2.58646253e-02, -3.40034775e-02, 4.55404669e-02,
+	-6.34318590e-02, 9.59257632e-02, -1.77752256e-01, 8.99851680e-01,
+	-1.05844538e-06, 1.09977564e-05, -3.79591620e-05, 9.59580866e-05,
+	-2.06598983e-04, 3.99541430e-04, -7.12760491e-04, 1.19267055e-03,
+	-1.89423806e-03, 2.88128131e-03, -4.22726898e-03, 6.01709681e-03,
+	-8.35062377e-03, 1.13492673e-02, -1.51679935e-02, 2.00171247e-02,
+	-2.62030084e-02, 3.42076309e-02, -4.48562838e-02, 5.97097054e-02,
+	-8.21287408e-02, 1.20893337e-01, -2.08294064e-01, 6.35306478e-01,
+	-1.83298312e-07, 5.16671707e-06, -2.04931366e-05, 5.48021671e-05,
+	-1.21991689e-04, 2.41587884e-04, -4.38962365e-04, 7.45437341e-04,
+	-1.19835651e-03, 1.84124697e-03, -2.72426917e-03, 3.90526047e-03,
+	-5.45185385e-03, 7.44548719e-03, -9.98870656e-03, 1.32184289e-02,
+	-1.73304621e-02, 2.26268210e-02, -2.96133142e-02, 3.92211117e-02,
+	-5.33831641e-02, 7.68678933e-02, -1.25398085e-01, 2.98713982e-01,
+	-0.00000000e+00, 2.86455845e-20, -2.12118913e-19, -6.07339852e-20,
+	-3.50340328e-19, 1.70862955e-18, -1.18686118e-18, -1.36586596e-18,
+	-2.96261064e-18, 1.26534910e-17, -6.00831199e-18, -9.92271056e-18,
+	-1.04471009e-17, 4.78129783e-17, -1.60975237e-17, 1.92303577e-17,
+	-2.24534703e-17, 2.56639154e-17, -2.87510974e-17, 3.16024651e-17,
+	-3.41094973e-17, 3.61736372e-17, -3.77117663e-17, 3.86608932e-17,
+};
+
@@ -0,0 +1,353 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+
+#include <math.h>
+#include "simd.h"
+#include "unimeterdsp.h"
+
+namespace LV2M {
+
+Unimeterdsp::Unimeterdsp (void) :
+    _nchan (0),
+    _nlane (0),
+    _ngrp (0),
+    _st (0),
+    _val (0),
+    _res (0),
+    _k (0),
+    _proc (0)
+{
+}
+
+
+Unimeterdsp::~Unimeterdsp (void)
+{
+    delete[] _st;
+    delete[] _val;
+    delete[] _res;
+}
+
+
+void Unimeterdsp::init (int nchan, float fsamp)
+{
+    _nchan = nchan;
+
+    switch (nchan)
+    {
+    case 1:  _nlane = 1; break;
+    case 2:  _nlane = 2; break;
+    default: _nlane = 4; break;
+    }
+    _ngrp = (nchan + _nlane - 1) / _nlane;
+
+    delete[] _st;
+    delete[] _val;
+    delete[] _res;
+    _st = new float [NSTATE * _nlane * _ngrp];
+    _val = new float [NMETER * _nchan];
+    _res = new bool [NMETER * _nchan];
+
+    // Same coefficients as Mchjmeterdsp.
+    _vw = 11.1f / fsamp;
+    _vg = 1.5f * 1.571f;
+
+    _aw1 =  450.0f / fsamp;
+    _aw2 = 1300.0f / fsamp;
+    _aw3 = 1.0f - 5.4f / fsamp;
+    _ag = 0.5108f;
+
+    _bw1 = 200.0f / fsamp;
+    _bw2 = 860.0f / fsamp;
+    _bw3 = 1.0f - 4.0f / fsamp;
+    _bg = 0.5141f;
+
+    _kw = 9.72f / fsamp;
+    {
+	const double a = 1.0 - _kw;
+	_d4 = (float)(1.0 - a * a * a * a);
+	const double g = _d4 / (1.0 - a * a * a * a);
+	for (int k = 0; k < 4; k++) _c [k] = (float)(g * _kw * pow (a, 3 - k));
+    }
+
+    switch (_nlane)
+    {
+    case 1:  _proc = &Unimeterdsp::process_all <float>; break;
+    case 2:  _proc = &Unimeterdsp::process_all <v2sf>; break;
+    default: _proc = &Unimeterdsp::process_all <v4sf>; break;
+    }
+    reset ();
+}
+
+
+void Unimeterdsp::reset (void)
+{
+    for (int i = 0; i < NSTATE * _nlane * _ngrp; i++) _st [i] = 0;
+    for (int i = 0; i < NMETER * _nchan; i++)
+    {
+	_val [i] = 0;
+	_res [i] = true;
+    }
+    _k = 0;
+}
+
+
+void Unimeterdsp::lanes (float * const *p, int g, const float *q [4]) const
+{
+    // Unused lanes of the last group duplicate its first channel,
+    // their results are never read.
+    for (int l = 0; l < _nlane; l++)
+    {
+	const int c = _nlane * g + l;
+	q [l] = p [c < _nchan ? c : _nlane * g];
+    }
+}
+
+
+static inline float clamp (float v, float lo, float hi)
+{
+    return v > hi ? hi : (v < lo ? lo : v);
+}
+
+
+// State of all meters for one lane group, and the per-sample and
+// per-group steps. The operations are the same, in the same order,
+// as in the Mchjmeterdsp kernels.
+
+template <typename V>
+struct Unilanes
+{
+    V vz1, vz2, vt, vm;          // VU
+    V az1, az2, am;              // IEC type I
+    V bz1, bz2, bm;              // IEC type II
+    V kz1, kz2;                  // K-meter RMS
+    V pk;                        // sample peak
+
+    V vw, vw4, aw1, aw2, aw3, bw1, bw2, bw3, kw, kw4, zero, half;
+
+    // Release of the PPMs and VU feedback for the next four samples.
+    void start (void)
+    {
+	vt = vz2 * half;
+	az1 *= aw3;
+	az2 *= aw3;
+	bz1 *= bw3;
+	bz2 *= bw3;
+    }
+
+    // Everything but the first K-meter filter.
+    void rect (V x)
+    {
+	typedef Lanes <V> L;
+	const V a = L::abs (x);
+	vz1 += vw * ((a - vt) - vz1);
+	az1 += aw1 * L::max (a - az1, zero);
+	az2 += aw2 * L::max (a - az2, zero);
+	bz1 += bw1 * L::max (a - bz1, zero);
+	bz2 += bw2 * L::max (a - bz2, zero);
+	pk = L::max (a, pk);
+    }
+
+    void sample (V x)
+    {
+	rect (x);
+	x *= x;
+	kz1 += kw * (x - kz1);
+    }
+
+    void end (void)
+    {
+	typedef Lanes <V> L;
+	vz2 += vw4 * (vz1 - vz2);
+	vm = L::max (vz2, vm);
+	am = L::max (az1 + az2, am);
+	bm = L::max (bz1 + bz2, bm);
+	kz2 += kw4 * (kz1 - kz2);
+    }
+};
+
+
+template <typename V>
+void Unimeterdsp::process_all (float * const *p, int n)
+{
+    typedef Lanes <V> L;
+    const int nl = _nlane * _ngrp;
+    const V d4 = L::set1 (_d4);
+    const V c0 = L::set1 (_c [0]);
+    const V c1 = L::set1 (_c [1]);
+    const V c2 = L::set1 (_c [2]);
+    const V c3 = L::set1 (_c [3]);
+    Unilanes <V> U;
+
+    U.vw = L::set1 (_vw);
+    U.vw4 = L::set1 (4 * _vw);
+    U.aw1 = L::set1 (_aw1);
+    U.aw2 = L::set1 (_aw2);
+    U.aw3 = L::set1 (_aw3);
+    U.bw1 = L::set1 (_bw1);
+    U.bw2 = L::set1 (_bw2);
+    U.bw3 = L::set1 (_bw3);
+    U.kw = L::set1 (_kw);
+    U.kw4 = L::set1 (4 * _kw);
+    U.zero = L::set1 (0);
+    U.half = L::set1 (0.5f);
+
+    for (int g = 0; g < _ngrp; g++)
+    {
+	const float *q [4];
+	float s [NSTATE][L::N];
+	V     x0, x1, x2, x3;
+	int   i, j, k, m;
+
+	lanes (p, g, q);
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    const float *st = _st + c;
+	    for (m = 0; m < NSTATE; m++) s [m][k] = st [m * nl];
+	    s [VZ1][k] = clamp (s [VZ1][k], -20, 20);
+	    s [VZ2][k] = clamp (s [VZ2][k], -20, 20);
+	    s [AZ1][k] = clamp (s [AZ1][k], 0, 20);
+	    s [AZ2][k] = clamp (s [AZ2][k], 0, 20);
+	    s [BZ1][k] = clamp (s [BZ1][k], 0, 20);
+	    s [BZ2][k] = clamp (s [BZ2][k], 0, 20);
+	    s [KZ1][k] = clamp (s [KZ1][k], 0, 50);
+	    s [KZ2][k] = clamp (s [KZ2][k], 0, 50);
+	    if (c < _nchan)
+	    {
+		if (_res [VU * _nchan + c])   s [VM][k] = 0;
+		if (_res [IEC1 * _nchan + c]) s [AM][k] = 0;
+		if (_res [IEC2 * _nchan + c]) s [BM][k] = 0;
+		if (_res [PEAK * _nchan + c]) s [PK][k] = 0;
+	    }
+	}
+	U.vz1 = L::load (s [VZ1]);
+	U.vz2 = L::load (s [VZ2]);
+	U.vm  = L::load (s [VM]);
+	U.az1 = L::load (s [AZ1]);
+	U.az2 = L::load (s [AZ2]);
+	U.am  = L::load (s [AM]);
+	U.bz1 = L::load (s [BZ1]);
+	U.bz2 = L::load (s [BZ2]);
+	U.bm  = L::load (s [BM]);
+	U.kz1 = L::load (s [KZ1]);
+	U.kz2 = L::load (s [KZ2]);
+	U.pk  = L::load (s [PK]);
+
+	// Complete the group of four left open by the previous cycle.
+	U.vt = U.vz2 * U.half;
+	for (i = 0, j = _k; j && i < n; i++)
+	{
+	    U.sample (L::gather (q, i));
+	    if (++j == 4)
+	    {
+		U.end ();
+		j = 0;
+	    }
+	}
+
+	for (; i + 4 <= n; i += 4)
+	{
+	    U.start ();
+	    x0 = L::gather (q, i);
+	    x1 = L::gather (q, i + 1);
+	    x2 = L::gather (q, i + 2);
+	    x3 = L::gather (q, i + 3);
+	    U.rect (x0);
+	    U.rect (x1);
+	    U.rect (x2);
+	    U.rect (x3);
+	    // First K-meter filter over four samples, see Kmeterdsp.
+	    x0 *= x0;
+	    x1 *= x1;
+	    x2 *= x2;
+	    x3 *= x3;
+	    U.kz1 += ((c0 * x0 + c1 * x1) + (c2 * x2 + c3 * x3)) - d4 * U.kz1;
+	    U.end ();
+	}
+
+	// Start a new group with the remaining samples.
+	if (i < n)
+	{
+	    U.start ();
+	    for (; i < n; i++) U.sample (L::gather (q, i));
+	}
+
+	L::store (s [VZ1], U.vz1);
+	L::store (s [VZ2], U.vz2);
+	L::store (s [VM],  U.vm);
+	L::store (s [AZ1], U.az1);
+	L::store (s [AZ2], U.az2);
+	L::store (s [AM],  U.am);
+	L::store (s [BZ1], U.bz1);
+	L::store (s [BZ2], U.bz2);
+	L::store (s [BM],  U.bm);
+	L::store (s [KZ1], U.kz1);
+	L::store (s [KZ2], U.kz2);
+	L::store (s [PK],  U.pk);
+
+	for (k = 0; k < L::N; k++)
+	{
+	    const int c = L::N * g + k;
+	    float *st = _st + c;
+	    float r;
+
+	    // Save filter state.
+	    if (!isfinite (s [VZ1][k])) { st [VZ1 * nl] = 0; s [VM][k] = INFINITY; } else st [VZ1 * nl] = s [VZ1][k];
+	    if (!isfinite (s [VZ2][k])) { st [VZ2 * nl] = 0; s [VM][k] = INFINITY; } else st [VZ2 * nl] = s [VZ2][k];
+	    if (isnan (s [KZ1][k])) s [KZ1][k] = 0;
+	    if (isnan (s [KZ2][k])) s [KZ2][k] = 0;
+	    st [VM * nl]  = s [VM][k];
+	    st [AZ1 * nl] = s [AZ1][k];
+	    st [AZ2 * nl] = s [AZ2][k];
+	    st [AM * nl]  = s [AM][k];
+	    st [BZ1 * nl] = s [BZ1][k];
+	    st [BZ2 * nl] = s [BZ2][k];
+	    st [BM * nl]  = s [BM][k];
+	    st [KZ1 * nl] = s [KZ1][k];
+	    st [KZ2 * nl] = s [KZ2][k];
+	    st [PK * nl]  = s [PK][k];
+	    if (c >= _nchan) continue;
+
+	    _val [VU * _nchan + c]   = _vg * s [VM][k];
+	    _val [IEC1 * _nchan + c] = _ag * s [AM][k];
+	    _val [IEC2 * _nchan + c] = _bg * s [BM][k];
+	    _val [PEAK * _nchan + c] = s [PK][k];
+
+	    r = sqrtf (2.0f * s [KZ2][k]);
+	    if (_res [KRMS * _nchan + c] || r > _val [KRMS * _nchan + c]) _val [KRMS * _nchan + c] = r;
+
+	    for (m = 0; m < NMETER; m++) _res [m * _nchan + c] = false;
+	}
+    }
+    _k = (_k + n) & 3;
+}
+
+
+float Unimeterdsp::read (int m, int c)
+{
+    _res [m * _nchan + c] = true;
+    return _val [m * _nchan + c];
+}
+
+}
+/* vi:set ts=8 sts=8 sw=4: */
@@ -0,0 +1,89 @@
+// ------------------------------------------------------------------------
+//
+//  Copyright (C) 2008-2012 Fons Adriaensen <fons@linuxaudio.org>
+//  Copyright (C) 2026 meters.lv2 contributors
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//
+// ------------------------------------------------------------------------
+
+
+
+#ifndef __UNIMETERDSP_H
+#define	__UNIMETERDSP_H
+
+namespace LV2M {
+
+// VU, IEC type I (DIN, Nordic), IEC type II (BBC, EBU), K-meter RMS and
+// sample peak of the same channels, computed in a single pass over the
+// input. The rectified and squared signal is shared by all meters; the
+// channels are the lanes of a vector as in Mchjmeterdsp.
+//
+// Readings are bit-identical to Mchjmeterdsp of the corresponding
+// type (K-meter: the rms value), except after silence, which only
+// Mchjmeterdsp skips in closed form (tools/test_blocksize).
+
+class Unimeterdsp
+{
+public:
+
+    enum Meter { VU, IEC1, IEC2, KRMS, PEAK, NMETER };
+
+    Unimeterdsp (void);
+    ~Unimeterdsp (void);
+
+    void  init (int nchan, float fsamp);
+    void  process (float * const *p, int n) { (this->*_proc) (p, n); }
+    float read (int m, int c);   // value of meter m, channel c since last read
+    void  reset (void);
+
+    int   nchan (void) const { return _nchan; }
+
+private:
+
+    // Per lane filter state and max values.
+    enum { VZ1, VZ2, VM, AZ1, AZ2, AM, BZ1, BZ2, BM, KZ1, KZ2, PK, NSTATE };
+
+    template <typename V> void process_all (float * const *p, int n);
+    void  lanes (float * const *p, int g, const float *q [4]) const;
+
+    int            _nchan;       // number of channels
+    int            _nlane;       // channels per register: 1, 2 or 4
+    int            _ngrp;        // number of lane groups
+    float         *_st;          // filter state and max values [NSTATE][_nlane * _ngrp]
+    float         *_val;         // readings since last read() [NMETER][_nchan]
+    bool          *_res;         // flag to reset a reading [NMETER][_nchan]
+    int            _k;           // samples into the current group of 4
+
+    float          _vw;          // VU filter coefficient
+    float          _vg;          // VU gain factor
+    float          _aw1;         // IEC type I attack filter coefficient
+    float          _aw2;         // IEC type I attack filter coefficient
+    float          _aw3;         // IEC type I release filter coefficient
+    float          _ag;          // IEC type I gain factor
+    float          _bw1;         // IEC type II attack filter coefficient
+    float          _bw2;         // IEC type II attack filter coefficient
+    float          _bw3;         // IEC type II release filter coefficient
+    float          _bg;          // IEC type II gain factor
+    float          _kw;          // K-meter filter coefficient
+    float          _d4;          // 1 - (1 - _kw)^4
+    float          _c [4];       // _kw * (1 - _kw)^(3-k)
+
+    void (Unimeterdsp::*_proc) (float * const *p, int n);
+};
+
+};
+
+#endif
@@ -9,7 +9,7 @@ static const RtkLv2Description _plugin_cor = {
 	, 10 // uint32_t dsp_descriptor_id
 	, 0 // uint32_t gui_descriptor_id
 	, "Stereo Phase-Correlation Meter" // const char *plugin_human_id
-	, (const struct LV2Port[6])
+	, (const struct LV2Port[10])
 	{
 		{ "unused", CONTROL_IN, 0.000000, 0.000000, 1.000000, "unused"},
 		{ "inL", AUDIO_IN, nan, nan, nan, "InL"},
@@ -17,17 +17,21 @@ static const RtkLv2Description _plugin_cor = {
 		{ "levelL", CONTROL_OUT, nan, 0.000000, 1.000000, "LevelL"},
 		{ "inR", AUDIO_IN, nan, nan, nan, "InR"},
 		{ "outR", AUDIO_OUT, nan, nan, nan, "OutR"},
+		{ "corfast", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Fast (50ms)"},
+		{ "corslow", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Slow (3s)"},
+		{ "cormin", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Minimum"},
+		{ "resetmin", CONTROL_IN, 0.000000, 0.000000, 1.000000, "Reset Minimum"},
 	}
-	, 6 // uint32_t nports_total
+	, 10 // uint32_t nports_total
 	, 2 // uint32_t nports_audio_in
 	, 2 // uint32_t nports_audio_out
 	, 0 // uint32_t nports_midi_in
 	, 0 // uint32_t nports_midi_out
 	, 0 // uint32_t nports_atom_in
 	, 0 // uint32_t nports_atom_out
-	, 2 // uint32_t nports_ctrl
-	, 1 // uint32_t nports_ctrl_in
-	, 1 // uint32_t nports_ctrl_out
+	, 6 // uint32_t nports_ctrl
+	, 2 // uint32_t nports_ctrl_in
+	, 4 // uint32_t nports_ctrl_out
 	, 8192 // uint32_t min_atom_bufsiz
 	, false // bool send_time_info
 	, UINT32_MAX // uint32_t latency_ctrl_port
@@ -10,7 +10,7 @@ static const RtkLv2Description _plugin_goniometer = {
 	, 12 // uint32_t dsp_descriptor_id
 	, 0 // uint32_t gui_descriptor_id
 	, "Goniometer" // const char *plugin_human_id
-	, (const struct LV2Port[7])
+	, (const struct LV2Port[11])
 	{
 		{ "inL", AUDIO_IN, nan, nan, nan, "InL"},
 		{ "outL", AUDIO_OUT, nan, nan, nan, "OutL"},
@@ -19,17 +19,21 @@ static const RtkLv2Description _plugin_goniometer = {
 		{ "UIgain", CONTROL_IN, 1.000000, 0.000000, 6.000000, "UI gain"},
 		{ "UIcorrelation", CONTROL_OUT, nan, 0.000000, 1.000000, "UI correlation"},
 		{ "UInotify", CONTROL_OUT, nan, 0.000000, 1.000000, "UI notify"},
+		{ "corfast", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Fast (50ms)"},
+		{ "corslow", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Slow (3s)"},
+		{ "cormin", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Minimum"},
+		{ "resetmin", CONTROL_IN, 0.000000, 0.000000, 1.000000, "Reset Minimum"},
 	}
-	, 7 // uint32_t nports_total
+	, 11 // uint32_t nports_total
 	, 2 // uint32_t nports_audio_in
 	, 2 // uint32_t nports_audio_out
 	, 0 // uint32_t nports_midi_in
 	, 0 // uint32_t nports_midi_out
 	, 0 // uint32_t nports_atom_in
 	, 0 // uint32_t nports_atom_out
-	, 3 // uint32_t nports_ctrl
-	, 1 // uint32_t nports_ctrl_in
-	, 2 // uint32_t nports_ctrl_out
+	, 7 // uint32_t nports_ctrl
+	, 2 // uint32_t nports_ctrl_in
+	, 5 // uint32_t nports_ctrl_out
 	, 8192 // uint32_t min_atom_bufsiz
 	, false // bool send_time_info
 	, UINT32_MAX // uint32_t latency_ctrl_port
@@ -10,7 +10,7 @@ static const RtkLv2Description _plugin_phasewheel = {
 	, 23 // uint32_t dsp_descriptor_id
 	, 0 // uint32_t gui_descriptor_id
 	, "Phase/Frequency Wheel" // const char *plugin_human_id
-	, (const struct LV2Port[13])
+	, (const struct LV2Port[17])
 	{
 		{ "control", ATOM_IN, nan, nan, nan, "GUI to plugin communication"},
 		{ "notify", ATOM_OUT, nan, nan, nan, "Plugin to GUI communication"},
@@ -25,17 +25,21 @@ static const RtkLv2Description _plugin_phasewheel = {
 		{ "band", CONTROL_IN, 1.000000, 0.000000, 1.000000, "Group data by frequency bands. Depending on FFT-size, 6 or 12 bands per octave are used. This allows for 1/frequency (pink noise) signal level normalization. It also speeds up visualization for large FFT sizes and decreases CPU/GPU usage due to visualization."},
 		{ "normalize", CONTROL_IN, 0.000000, 0.000000, 1.000000, "Auto-gain. Normalize signal level, set gain to detected (per band) peak signal level."},
 		{ "persistence", CONTROL_IN, 33.000000, 0.000000, 100.000000, "Screen persistence (fade out speed). 0: no persistence, 100: permanent. Values above ~66 result in a permanent shadow."},
+		{ "corfast", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Fast (50ms)"},
+		{ "corslow", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Slow (3s)"},
+		{ "cormin", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation Minimum"},
+		{ "resetmin", CONTROL_IN, 0.000000, 0.000000, 1.000000, "Reset Minimum"},
 	}
-	, 13 // uint32_t nports_total
+	, 17 // uint32_t nports_total
 	, 2 // uint32_t nports_audio_in
 	, 2 // uint32_t nports_audio_out
 	, 0 // uint32_t nports_midi_in
 	, 0 // uint32_t nports_midi_out
 	, 1 // uint32_t nports_atom_in
 	, 1 // uint32_t nports_atom_out
-	, 7 // uint32_t nports_ctrl
-	, 6 // uint32_t nports_ctrl_in
-	, 1 // uint32_t nports_ctrl_out
+	, 11 // uint32_t nports_ctrl
+	, 7 // uint32_t nports_ctrl_in
+	, 4 // uint32_t nports_ctrl_out
 	, 65888 // uint32_t min_atom_bufsiz
 	, false // bool send_time_info
 	, UINT32_MAX // uint32_t latency_ctrl_port
@@ -10,7 +10,7 @@ static const RtkLv2Description _plugin_surmeter = {
 	, 32 // uint32_t dsp_descriptor_id
 	, 0 // uint32_t gui_descriptor_id
 	, "Surround Level 8" // const char *plugin_human_id
-	, (const struct LV2Port[45])
+	, (const struct LV2Port[59])
 	{
 		{ "rmsgain", CONTROL_IN, 0.000000, -20.000000, 20.000000, "gui rms gain"},
 		{ "cor1A", CONTROL_IN, 0.000000, 0.000000, 7.000000, "Correlation 1, Input A"},
@@ -57,17 +57,31 @@ static const RtkLv2Description _plugin_surmeter = {
 		{ "out8", AUDIO_OUT, nan, nan, nan, "Out8"},
 		{ "rms8", CONTROL_OUT, nan, 0.000000, 1.000000, "RMS 8"},
 		{ "peak8", CONTROL_OUT, nan, 0.000000, 1.000000, "Peak 8"},
+		{ "notify", ATOM_OUT, nan, nan, nan, "Correlation Matrix"},
+		{ "corfast1", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 1 Fast (50ms)"},
+		{ "corslow1", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 1 Slow (3s)"},
+		{ "cormin1", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 1 Minimum"},
+		{ "corfast2", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 2 Fast (50ms)"},
+		{ "corslow2", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 2 Slow (3s)"},
+		{ "cormin2", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 2 Minimum"},
+		{ "corfast3", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 3 Fast (50ms)"},
+		{ "corslow3", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 3 Slow (3s)"},
+		{ "cormin3", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 3 Minimum"},
+		{ "corfast4", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 4 Fast (50ms)"},
+		{ "corslow4", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 4 Slow (3s)"},
+		{ "cormin4", CONTROL_OUT, nan, -1.000000, 1.000000, "Correlation 4 Minimum"},
+		{ "resetmin", CONTROL_IN, 0.000000, 0.000000, 1.000000, "Reset Minimum"},
 	}
-	, 45 // uint32_t nports_total
+	, 59 // uint32_t nports_total
 	, 8 // uint32_t nports_audio_in
 	, 8 // uint32_t nports_audio_out
 	, 0 // uint32_t nports_midi_in
 	, 0 // uint32_t nports_midi_out
 	, 0 // uint32_t nports_atom_in
-	, 0 // uint32_t nports_atom_out
-	, 29 // uint32_t nports_ctrl
-	, 9 // uint32_t nports_ctrl_in
-	, 20 // uint32_t nports_ctrl_out
+	, 1 // uint32_t nports_atom_out
+	, 42 // uint32_t nports_ctrl
+	, 10 // uint32_t nports_ctrl_in
+	, 32 // uint32_t nports_ctrl_out
 	, 8192 // uint32_t min_atom_bufsiz
 	, false // bool send_time_info
 	, UINT32_MAX // uint32_t latency_ctrl_port
@@ -0,0 +1,115 @@
+/* meter.lv2 -- multiband phase correlation
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+/******************************************************************************
+ * LV2
+ *
+ * ports: inL, outL, inR, outR, followed by the correlation
+ *        of each band, lowest band first
+ */
+
+static LV2_Handle
+bcor_instantiate(
+		const LV2_Descriptor*     descriptor,
+		double                    rate,
+		const char*               bundle_path,
+		const LV2_Feature* const* features)
+{
+	int bpo;
+	if (       !strcmp (descriptor->URI, MTR_URI "bandcorrelation")) {
+		bpo = 1;
+	} else if (!strcmp (descriptor->URI, MTR_URI "bandcorrelation3")) {
+		bpo = 3;
+	} else {
+		return NULL;
+	}
+
+	LV2meter* self = (LV2meter*)calloc (1, sizeof (LV2meter));
+	if (!self) return NULL;
+
+	self->chn = 2;
+	self->bcor = new Bandcorrdsp();
+	self->bcor->init (rate, bpo, 0.3f);
+
+	self->level  = (float**) calloc (self->bcor->nband (), sizeof (float*));
+	self->input  = (float**) calloc (self->chn, sizeof (float*));
+	self->output = (float**) calloc (self->chn, sizeof (float*));
+
+	return (LV2_Handle)self;
+}
+
+static void
+bcor_connect_port (LV2_Handle instance, uint32_t port, void* data)
+{
+	LV2meter* self = (LV2meter*)instance;
+	if (port < 4) {
+		if (port & 1) {
+			self->output[port / 2] = (float*) data;
+		} else {
+			self->input[port / 2] = (float*) data;
+		}
+	}
+	else if (port < 4 + (uint32_t) self->bcor->nband ()) {
+		self->level[port - 4] = (float*) data;
+	}
+}
+
+static void
+bcor_run(LV2_Handle instance, uint32_t n_samples)
+{
+	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
+
+	self->bcor->process (self->input[0], self->input[1], n_samples);
+
+	for (int b = 0; b < self->bcor->nband (); ++b) {
+		*self->level[b] = self->bcor->read (b);
+	}
+
+	for (uint32_t c = 0; c < self->chn; ++c) {
+		if (self->input[c] != self->output[c]) {
+			memcpy(self->output[c], self->input[c], sizeof(float) * n_samples);
+		}
+	}
+}
+
+static void
+bcor_cleanup(LV2_Handle instance)
+{
+	LV2meter* self = (LV2meter*)instance;
+	delete self->bcor;
+	FREE_VARPORTS;
+	free(instance);
+}
+
+#define BcorDesc(ID, NAME) \
+static const LV2_Descriptor descriptor ## ID = { \
+	MTR_URI NAME, \
+	bcor_instantiate, \
+	bcor_connect_port, \
+	NULL, \
+	bcor_run, \
+	NULL, \
+	bcor_cleanup, \
+	extension_data \
+};
+
+BcorDesc(BCOR1, "bandcorrelation");
+BcorDesc(BCOR3, "bandcorrelation3");
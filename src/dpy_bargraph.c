@@ -131,7 +131,7 @@ bargraph_render (LV2_Handle instance, uint32_t w, uint32_t max_h)
 
 	for (uint32_t c = 0; c < self->chn; ++c) {
 		float v = self->mval[c];
-		v = v > .000031623f ? 20.0 * log10f(v) : -90.0;
+		v = v > .000031623f ? fast_coeff_to_db(v) : -90.0;
 		v = w * kmeter_deflect (v, self->kstandard);
 		cairo_rectangle (cr, 1, c * ypc, v, ypc - 1);
 		cairo_set_source(cr, self->mpat);
@@ -81,7 +81,7 @@ typedef struct {
 	uint64_t sample_count;
 
 	Kmeterdsp *km[DR_CHANNELS];
-	TruePeakdsp *tp[DR_CHANNELS];
+	Mchtruepeakdsp *tp;
 
 	float rms_sum[DR_CHANNELS];
 	float peak_cur[DR_CHANNELS];
@@ -153,15 +153,15 @@ dr14_instantiate(
 
 	for (uint32_t c = 0; c < self->n_channels; ++c) {
 		self->km[c] = new Kmeterdsp();
-		self->tp[c] = new TruePeakdsp();
 		self->km[c]->init(rate);
-		self->tp[c]->init(rate);
 		self->m_rms[c] = -81;
 		self->m_peak[c] = -81;
 		if (dr_operation_mode) {
 			self->hist[c] = (uint32_t*) calloc(DR_HISTBINS, sizeof(uint32_t));
 		}
 	}
+	self->tp = new Mchtruepeakdsp();
+	self->tp->init(self->n_channels, rate);
 
 	return (LV2_Handle)self;
 }
@@ -235,12 +235,12 @@ dr14_connect_port(LV2_Handle instance, uint32_t port, void* data)
 
 static inline float coeff_to_db(const float coeff) {
 	if (coeff < .0001) return -80;
-	return 20 * log10f(coeff);
+	return fast_coeff_to_db(coeff);
 }
 
 static inline float db_to_coeff(const float db) {
 	if (db <= -80) return 0;
-	return powf(10, 0.05 * db);
+	return fast_db_to_coeff(db);
 }
 
 static void
@@ -355,6 +355,7 @@ static void
 dr14_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2dr14* self = (LV2dr14*)instance;
+	DenormalGuard dg;
 
 	self->follow_host_transport = (*self->p_follow_host_transport != 0);
 
@@ -390,8 +391,8 @@ dr14_run(LV2_Handle instance, uint32_t n_samples)
 	 */
 	for (uint32_t c = 0; c < self->n_channels; ++c) {
 		self->km[c]->process(self->p_input[c], n_samples);
-		self->tp[c]->process(self->p_input[c], n_samples);
 	}
+	self->tp->process(self->p_input, n_samples);
 
 	/* DR specs says RMS is to be calculated over a 3 second
 	 * non-overlapping window. Aaarg! well, this is not the place
@@ -425,7 +426,7 @@ dr14_run(LV2_Handle instance, uint32_t n_samples)
 	for (uint32_t c = 0; c < self->n_channels; ++c) {
 		float rv, rp;
 		float pv, pp;
-		self->tp[c]->read(pv, pp);
+		self->tp->read(c, pv, pp);
 		self->km[c]->read(rv, rp);
 		self->m_dbtp[c] = MAX(self->m_dbtp[c], pp);
 
@@ -488,11 +489,11 @@ dr14_cleanup(LV2_Handle instance)
 
 	for (uint32_t c = 0; c < self->n_channels; ++c) {
 		delete self->km[c];
-		delete self->tp[c];
 		if (self->dr_operation_mode) {
 			free(self->hist[c]);
 		}
 	}
+	delete self->tp;
 	free(instance);
 }
 
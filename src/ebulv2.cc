@@ -33,6 +33,52 @@ typedef enum {
 	EBU_OUTPUT1  = 5,
 } EBUPortIndex;
 
+/* immersive variants: [in, out] per channel from EBU_INPUT0 on,
+ * channel order and positions as in ITU-R BS.2051 */
+
+static const Ebu_r128_chan ebu_layout_5_1 [] = {
+	{ "L",     30, 0, false }, { "R",    -30, 0, false },
+	{ "C",      0, 0, false }, { "LFE",    0, 0, true  },
+	{ "Ls",   110, 0, false }, { "Rs",  -110, 0, false },
+};
+
+static const Ebu_r128_chan ebu_layout_7_1_4 [] = {
+	{ "L",     30,  0, false }, { "R",    -30,  0, false },
+	{ "C",      0,  0, false }, { "LFE",    0,  0, true  },
+	{ "Lss",   90,  0, false }, { "Rss",  -90,  0, false },
+	{ "Lrs",  135,  0, false }, { "Rrs", -135,  0, false },
+	{ "Ltf",   45, 30, false }, { "Rtf",  -45, 30, false },
+	{ "Ltb",  135, 30, false }, { "Rtb", -135, 30, false },
+};
+
+static const Ebu_r128_chan ebu_layout_9_1_6 [] = {
+	{ "L",     30,  0, false }, { "R",    -30,  0, false },
+	{ "C",      0,  0, false }, { "LFE",    0,  0, true  },
+	{ "Lss",   90,  0, false }, { "Rss",  -90,  0, false },
+	{ "Lrs",  135,  0, false }, { "Rrs", -135,  0, false },
+	{ "Lw",    60,  0, false }, { "Rw",   -60,  0, false },
+	{ "Ltf",   45, 30, false }, { "Rtf",  -45, 30, false },
+	{ "Ltm",   90, 30, false }, { "Rtm",  -90, 30, false },
+	{ "Ltb",  135, 30, false }, { "Rtb", -135, 30, false },
+};
+
+static const Ebu_r128_chan ebu_layout_22_2 [] = {
+	{ "FL",    60,   0, false }, { "FR",    -60,   0, false },
+	{ "FC",     0,   0, false }, { "LFE1",   45, -30, true  },
+	{ "BL",   135,   0, false }, { "BR",   -135,   0, false },
+	{ "FLc",   30,   0, false }, { "FRc",   -30,   0, false },
+	{ "BC",   180,   0, false }, { "LFE2",  -45, -30, true  },
+	{ "SiL",   90,   0, false }, { "SiR",   -90,   0, false },
+	{ "TpFL",  45,  30, false }, { "TpFR",  -45,  30, false },
+	{ "TpFC",   0,  30, false }, { "TpC",     0,  90, false },
+	{ "TpBL", 135,  30, false }, { "TpBR", -135,  30, false },
+	{ "TpSiL", 90,  30, false }, { "TpSiR", -90,  30, false },
+	{ "TpBC", 180,  30, false }, { "BtFC",    0, -30, false },
+	{ "BtFL",  45, -30, false }, { "BtFR",  -45, -30, false },
+};
+
+#define EBU_NCHAN(L) (sizeof (L) / sizeof (Ebu_r128_chan))
+
 
 /******************************************************************************
  * helper functions
@@ -54,6 +100,7 @@ static void ebu_reset(LV2meter* self) {
 	self->hist_maxM = 0;
 	self->hist_maxS = 0;
 	self->tp_max = -INFINITY;
+	self->tp_hold = 0;
 }
 
 static void ebu_integrate(LV2meter* self, bool on) {
@@ -119,14 +166,28 @@ ebur128_instantiate(
 		const char*               bundle_path,
 		const LV2_Feature* const* features)
 {
-	LV2meter* self = (LV2meter*)calloc(1, sizeof(LV2meter));
-	if (!self) return NULL;
-
-	if (strcmp(descriptor->URI, MTR_URI "EBUr128")) {
-		free(self);
+	uint32_t nchan = 2;
+	const Ebu_r128_chan* layout = NULL;
+
+	if (!strcmp(descriptor->URI, MTR_URI "EBUr128_5_1")) {
+		layout = ebu_layout_5_1;
+		nchan = EBU_NCHAN(ebu_layout_5_1);
+	} else if (!strcmp(descriptor->URI, MTR_URI "EBUr128_7_1_4")) {
+		layout = ebu_layout_7_1_4;
+		nchan = EBU_NCHAN(ebu_layout_7_1_4);
+	} else if (!strcmp(descriptor->URI, MTR_URI "EBUr128_9_1_6")) {
+		layout = ebu_layout_9_1_6;
+		nchan = EBU_NCHAN(ebu_layout_9_1_6);
+	} else if (!strcmp(descriptor->URI, MTR_URI "EBUr128_22_2")) {
+		layout = ebu_layout_22_2;
+		nchan = EBU_NCHAN(ebu_layout_22_2);
+	} else if (strcmp(descriptor->URI, MTR_URI "EBUr128")) {
 		return NULL;
 	}
 
+	LV2meter* self = (LV2meter*)calloc(1, sizeof(LV2meter));
+	if (!self) return NULL;
+
 	for (int i=0; features[i]; ++i) {
 		if (!strcmp(features[i]->URI, LV2_URID__map)) {
 			self->map = (LV2_URID_Map*)features[i]->data;
@@ -142,7 +203,7 @@ ebur128_instantiate(
 	map_eburlv2_uris(self->map, &self->uris);
 	lv2_atom_forge_init(&self->forge, self->map);
 
-	self->chn = 2;
+	self->chn = nchan;
 	self->input  = (float**) calloc (self->chn, sizeof (float*));
 	self->output = (float**) calloc (self->chn, sizeof (float*));
 
@@ -181,15 +242,21 @@ ebur128_instantiate(
 	self->hist_maxM = 0;
 	self->hist_maxS = 0;
 	self->tp_max = -INFINITY;
+	self->tp_hold = 0;
 
 	self->ebu = new Ebu_r128_proc();
-	self->ebu->init (2, rate);
+	self->ebu->init (self->chn, rate);
+	if (layout) {
+		self->ebu->set_layout (layout);
+	}
+	/* the 1/800 LU histograms (about 2MB) are always fed, ui_settings
+	 * bit 7 selects them for the integrated loudness and range */
+	self->ebu->integr_exact (true);
 
-	self->mtr = (JmeterDSP **)malloc (2 * sizeof (JmeterDSP *));
-	self->mtr[0] = new TruePeakdsp();
-	self->mtr[1] = new TruePeakdsp();
-	static_cast<TruePeakdsp *>(self->mtr[0])->init(rate);
-	static_cast<TruePeakdsp *>(self->mtr[1])->init(rate);
+	self->mtp = new Mchtruepeakdsp();
+	self->mtp->init(self->chn, rate);
+	/* only oversample when the max can change */
+	self->mtp->set_lazy(self->mtp->bound());
 
 	return (LV2_Handle)self;
 }
@@ -199,30 +266,27 @@ ebur128_connect_port(LV2_Handle instance, uint32_t port, void* data)
 {
 	LV2meter* self = (LV2meter*)instance;
 	switch ((EBUPortIndex)port) {
-	case EBU_INPUT0:
-		self->input[0] = (float*) data;
-		break;
-	case EBU_OUTPUT0:
-		self->output[0] = (float*) data;
-		break;
-	case EBU_INPUT1:
-		self->input[1] = (float*) data;
-		break;
-	case EBU_OUTPUT1:
-		self->output[1] = (float*) data;
-		break;
 	case EBU_NOTIFY:
 		self->notify = (LV2_Atom_Sequence*)data;
 		break;
 	case EBU_CONTROL:
 		self->control = (const LV2_Atom_Sequence*)data;
 		break;
+	default:
+		if (port >= EBU_INPUT0 && port < EBU_INPUT0 + 2 * self->chn) {
+			if ((port - EBU_INPUT0) & 1) {
+				self->output[(port - EBU_INPUT0) / 2] = (float*) data;
+			} else {
+				self->input[(port - EBU_INPUT0) / 2] = (float*) data;
+			}
+		}
+		break;
 	}
 }
 
 static inline float coef_to_db (const float val) {
 	if (val == 0) return -INFINITY;
-	return 20.0 * log10f(val);
+	return fast_coeff_to_db(val);
 }
 
 #define DEBUG_FORGE(VAR,NAME) \
@@ -236,6 +300,7 @@ static void
 ebur128_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 
 	const uint32_t capacity = self->notify->atom.size;
 	assert(capacity > 920);
@@ -334,12 +399,10 @@ ebur128_run(LV2_Handle instance, uint32_t n_samples)
 #endif
 
 	/* process audio -- delayline + balance & gain */
-	float *input [] = {self->input[0], self->input[1]};
-	self->ebu->process(n_samples, input);
+	self->ebu->process(n_samples, self->input);
 
 	if (self->dbtp_enable) {
-		static_cast<TruePeakdsp*>(self->mtr[0])->process_max(self->input[0], n_samples);
-		static_cast<TruePeakdsp*>(self->mtr[1])->process_max(self->input[1], n_samples);
+		self->mtp->process_max(self->input, n_samples, self->tp_hold);
 	}
 
 	/* get processed data */
@@ -349,17 +412,20 @@ ebur128_run(LV2_Handle instance, uint32_t n_samples)
 	const float ls = self->ebu->loudness_S();
 	float ms = self->ebu->maxloudn_S();
 
-	const float il = self->ebu->integrated();
-	const float rn = self->ebu->range_min();
-	const float rx = self->ebu->range_max();
+	const bool exact = (self->ui_settings & 128) ? true : false;
+	const float il = exact ? self->ebu->integrated_exact() : self->ebu->integrated();
+	const float rn = exact ? self->ebu->range_min_exact() : self->ebu->range_min();
+	const float rx = exact ? self->ebu->range_max_exact() : self->ebu->range_max();
 
 	if (self->dbtp_enable) {
-		const float tp0 = self->mtr[0]->read();
-		const float tp1 = self->mtr[1]->read();
-		const float tp = coef_to_db(tp0 > tp1 ? tp0 : tp1);
-		if (tp > self->tp_max) self->tp_max = tp;
+		const float tp = self->mtp->read_max();
+		if (tp > self->tp_hold) {
+			self->tp_hold = tp;
+			self->tp_max = coef_to_db(tp);
+		}
 	} else {
 		self->tp_max = -INFINITY;
+		self->tp_hold = 0;
 	}
 	
 	if (self->radar_resync >= 0) {
@@ -460,7 +526,7 @@ ebur128_run(LV2_Handle instance, uint32_t n_samples)
 
 	/* report values to UI - TODO only if changed*/
 	if (self->ui_active) {
-		LV2_Atom_Forge_Frame frame; // max 264 bytes
+		LV2_Atom_Forge_Frame frame; // max 288 bytes
 		lv2_atom_forge_frame_time(&self->forge, 0);
 		x_forge_object(&self->forge, &frame, 1, self->uris.mtr_ebulevels);
 		lv2_atom_forge_property_head(&self->forge, self->uris.ebu_loudnessM, 0);   lv2_atom_forge_float(&self->forge, lm);
@@ -471,17 +537,17 @@ ebur128_run(LV2_Handle instance, uint32_t n_samples)
 		lv2_atom_forge_property_head(&self->forge, self->uris.ebu_range_min, 0);   lv2_atom_forge_float(&self->forge, rn);
 		lv2_atom_forge_property_head(&self->forge, self->uris.ebu_range_max, 0);   lv2_atom_forge_float(&self->forge, rx);
 		lv2_atom_forge_property_head(&self->forge, self->uris.mtr_truepeak, 0);    lv2_atom_forge_float(&self->forge, self->tp_max);
+		lv2_atom_forge_property_head(&self->forge, self->uris.mtr_tpfactor, 0);    lv2_atom_forge_int(&self->forge, self->mtp->factor());
 		lv2_atom_forge_property_head(&self->forge, self->uris.ebu_integrating, 0); lv2_atom_forge_bool(&self->forge, self->ebu_integrating);
 		lv2_atom_forge_property_head(&self->forge, self->uris.ebu_integr_time, 0); lv2_atom_forge_float(&self->forge, (self->integration_time/ self->rate));
 
 		lv2_atom_forge_pop(&self->forge, &frame);
 	}
 
-	if (self->input[0] != self->output[0]) {
-		memcpy(self->output[0], self->input[0], sizeof(float) * n_samples);
-	}
-	if (self->input[1] != self->output[1]) {
-		memcpy(self->output[1], self->input[1], sizeof(float) * n_samples);
+	for (uint32_t c = 0; c < self->chn; ++c) {
+		if (self->input[c] != self->output[c]) {
+			memcpy(self->output[c], self->input[c], sizeof(float) * n_samples);
+		}
 	}
 #if 0
 	//printf("forged %d bytes\n", self->notify->atom.size);
@@ -500,9 +566,7 @@ ebur128_cleanup(LV2_Handle instance)
 	free(self->radarS);
 	free(self->radarM);
 	delete self->ebu;
-	delete self->mtr[0];
-	delete self->mtr[1];
-	free (self->mtr);
+	delete self->mtp;
 	FREE_VARPORTS;
 	free(instance);
 }
@@ -561,13 +625,20 @@ extension_data_ebur(const char* uri)
   return NULL;
 }
 
-static const LV2_Descriptor descriptorEBUr128 = {
-	MTR_URI "EBUr128",
-	ebur128_instantiate,
-	ebur128_connect_port,
-	NULL,
-	ebur128_run,
-	NULL,
-	ebur128_cleanup,
-	extension_data_ebur
+#define EbuDesc(ID, NAME) \
+static const LV2_Descriptor descriptor ## ID = { \
+	MTR_URI NAME, \
+	ebur128_instantiate, \
+	ebur128_connect_port, \
+	NULL, \
+	ebur128_run, \
+	NULL, \
+	ebur128_cleanup, \
+	extension_data_ebur \
 };
+
+EbuDesc(EBUr128, "EBUr128");
+EbuDesc(EBUr128_51, "EBUr128_5_1");
+EbuDesc(EBUr128_714, "EBUr128_7_1_4");
+EbuDesc(EBUr128_916, "EBUr128_9_1_6");
+EbuDesc(EBUr128_222, "EBUr128_22_2");
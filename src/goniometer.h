@@ -141,6 +141,10 @@ typedef struct {
 	float* gain;
 	float* notify;
 	float* correlation;
+	float* cor_fast;
+	float* cor_slow;
+	float* cor_min;
+	float* cor_reset;
 
 	double rate;
 
@@ -32,6 +32,10 @@ typedef enum {
 	JF_GAIN     = 4,
 	JF_CORR     = 5,
 	JF_NOTIFY   = 6,
+	JF_CORFAST  = 7,
+	JF_CORSLOW  = 8,
+	JF_CORMIN   = 9,
+	JF_CORRESET = 10,
 } JFPortIndex;
 
 #include "goniometer.h"
@@ -103,8 +107,12 @@ goniometer_instantiate(
 	self->s_gtarget = 40.0;
 	self->s_grms = 50.0;
 
+	/* the ringbuffer must hold at least two cycles,
+	 * use a generous default if the host does not tell */
+	const uint32_t blksiz = lv2_block_length(features);
 	uint32_t rbsize = self->rate / 5;
-	if (rbsize < 8192u) rbsize = 8192u;
+	if (blksiz == 0 && rbsize < 8192u) rbsize = 8192u;
+	if (rbsize < 2 * blksiz) rbsize = 2 * blksiz;
 	if (rbsize < 2 * self->apv) rbsize = 2 * self->apv;
 
 	self->rb = gmrb_alloc(rbsize);
@@ -138,6 +146,18 @@ goniometer_connect_port(LV2_Handle instance, uint32_t port, void* data)
 	case JF_NOTIFY:
 		self->notify = (float*) data;
 		break;
+	case JF_CORFAST:
+		self->cor_fast = (float*) data;
+		break;
+	case JF_CORSLOW:
+		self->cor_slow = (float*) data;
+		break;
+	case JF_CORMIN:
+		self->cor_min = (float*) data;
+		break;
+	case JF_CORRESET:
+		self->cor_reset = (float*) data;
+		break;
 	}
 }
 
@@ -145,8 +165,15 @@ static void
 goniometer_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2gm* self = (LV2gm*)instance;
+	DenormalGuard dg;
 
+	if (*self->cor_reset > 0) {
+		self->cor->reset_min();
+	}
 	self->cor->process(self->input[0], self->input[1] , n_samples);
+	*self->cor_fast = self->cor->read(Stcorrdsp::FAST);
+	*self->cor_slow = self->cor->read(Stcorrdsp::SLOW);
+	*self->cor_min  = self->cor->read_min();
 
 	if (self->ui_active) {
 		if (gmrb_write(self->rb, self->input[0], self->input[1], n_samples) < 0) {
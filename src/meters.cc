@@ -24,13 +24,17 @@
 #include "lv2/lv2plug.in/ns/lv2core/lv2.h"
 
 #include "../jmeters/jmeterdsp.h"
-#include "../jmeters/vumeterdsp.h"
-#include "../jmeters/iec1ppmdsp.h"
-#include "../jmeters/iec2ppmdsp.h"
-#include "../jmeters/msppmdsp.h"
+#include "../jmeters/mtxppmdsp.h"
 #include "../jmeters/stcorrdsp.h"
-#include "../jmeters/truepeakdsp.h"
+#include "../jmeters/mchcorrdsp.h"
 #include "../jmeters/kmeterdsp.h"
+#include "../jmeters/mchjmeterdsp.h"
+#include "../jmeters/mchtruepeakdsp.h"
+#include "../jmeters/unimeterdsp.h"
+#include "../jmeters/bandcorrdsp.h"
+#include "../jmeters/simd.h"
+#include "../jmeters/fastmath.h"
+#include "../jmeters/denormal.h"
 #include "../ebumeter/ebu_r128_proc.h"
 
 #include "uris.h"
@@ -65,6 +69,14 @@ typedef enum {
 	MTR_HOLD     = 9
 } PortIndex;
 
+/* correlation meter, ports 0-5 as above */
+typedef enum {
+	COR_FAST     = 6,
+	COR_SLOW     = 7,
+	COR_MIN      = 8,
+	COR_RESET    = 9
+} CorPortIndex;
+
 enum MtrType {
 	MT_NONE = 0,
 	MT_BBC,
@@ -83,15 +95,25 @@ typedef struct {
 
 	enum MtrType type;
 
-	JmeterDSP **mtr;
+	Mchjmeterdsp *mch;
+	Mchtruepeakdsp *mtp;
 	Stcorrdsp *cor;
-	Msppmdsp  *bms[2];
+	float* cor_fast;
+	float* cor_slow;
+	float* cor_min;
+	float* cor_reset;
+	Mtxppmdsp *mtx;
+	Unimeterdsp *uni;
+	Bandcorrdsp *bcor;
 	Ebu_r128_proc *ebu;
 
-	Stcorrdsp *cor4[4];
+	Mchcorrdsp *mcor;
 	float* surc_a[4];
 	float* surc_b[4];
 	float* surc_c[4];
+	float* surc_f[4];
+	float* surc_s[4];
+	float* surc_m[4];
 
 	float** level;
 	float** input;
@@ -134,6 +156,7 @@ typedef struct {
 	bool send_state_to_ui;
 	uint32_t ui_settings;
 	float tp_max;
+	float tp_hold; // tp_max as coefficient
 
 	int histM[HIST_LEN];
 	int32_t histS[HIST_LEN];
@@ -164,24 +187,38 @@ typedef struct {
 } LV2meter;
 
 
-#define MTRDEF(NAME, CLASS, TYPE, KM) \
+/* needle and K-meters: all channels in one multi-channel engine */
+#define MCHDEF(NAME, MCHTYPE, TYPE, KM) \
 	else if (!strcmp(descriptor->URI, MTR_URI NAME "mono")) { \
 		self->chn = 1; \
 		self->kstandard = KM; \
 		self->type = TYPE; \
-		self->mtr = (JmeterDSP **)malloc (self->chn * sizeof (JmeterDSP *)); \
-		self->mtr[0] = new CLASS(); \
-		static_cast<CLASS *>(self->mtr[0])->init(rate); \
+		self->mch = new Mchjmeterdsp(); \
+		self->mch->init(Mchjmeterdsp::MCHTYPE, self->chn, rate); \
 	} \
 	else if (!strcmp(descriptor->URI, MTR_URI NAME "stereo")) { \
 		self->chn = 2; \
 		self->kstandard = KM; \
 		self->type = TYPE; \
-		self->mtr = (JmeterDSP **)malloc (self->chn * sizeof (JmeterDSP *)); \
-		self->mtr[0] = new CLASS(); \
-		self->mtr[1] = new CLASS(); \
-		static_cast<CLASS *>(self->mtr[0])->init(rate); \
-		static_cast<CLASS *>(self->mtr[1])->init(rate); \
+		self->mch = new Mchjmeterdsp(); \
+		self->mch->init(Mchjmeterdsp::MCHTYPE, self->chn, rate); \
+	}
+
+/* true-peak meters: all channels in one oversampling pass */
+#define MTPDEF(NAME, TYPE, KM) \
+	else if (!strcmp(descriptor->URI, MTR_URI NAME "mono")) { \
+		self->chn = 1; \
+		self->kstandard = KM; \
+		self->type = TYPE; \
+		self->mtp = new Mchtruepeakdsp(); \
+		self->mtp->init(self->chn, rate); \
+	} \
+	else if (!strcmp(descriptor->URI, MTR_URI NAME "stereo")) { \
+		self->chn = 2; \
+		self->kstandard = KM; \
+		self->type = TYPE; \
+		self->mtp = new Mchtruepeakdsp(); \
+		self->mtp->init(self->chn, rate); \
 	}
 
 static LV2_Handle
@@ -203,19 +240,23 @@ instantiate(const LV2_Descriptor*     descriptor,
 	else if (!strcmp(descriptor->URI, MTR_URI "BBCM6")) {
 		self->chn = 2;
 		self->type = MT_BM6; \
-		self->bms[0] = new Msppmdsp(-6);
-		self->bms[1] = new Msppmdsp(-6);
-		self->bms[0]->init(rate);
-	}
-	MTRDEF("VU",   Vumeterdsp,  MT_VU,   0)
-	MTRDEF("BBC",  Iec2ppmdsp,  MT_BBC,  0)
-	MTRDEF("EBU",  Iec2ppmdsp,  MT_EBU,  0)
-	MTRDEF("DIN",  Iec1ppmdsp,  MT_DIN,  0)
-	MTRDEF("NOR",  Iec1ppmdsp,  MT_NOR,  0)
-	MTRDEF("dBTP", TruePeakdsp, MT_NONE, 0)
-	MTRDEF("K12",  Kmeterdsp,   MT_NONE, 12)
-	MTRDEF("K14",  Kmeterdsp,   MT_NONE, 14)
-	MTRDEF("K20",  Kmeterdsp,   MT_NONE, 20)
+		/* M = L + R, S = L - R */
+		self->mtx = new Mtxppmdsp();
+		self->mtx->init(Mtxppmdsp::IEC2, 2, 2, rate);
+		self->mtx->set_coef(0, 0,  1); self->mtx->set_coef(0, 1,  1);
+		self->mtx->set_coef(1, 0,  1); self->mtx->set_coef(1, 1, -1);
+		self->mtx->set_gain(0, -6);
+		self->mtx->set_gain(1, -6);
+	}
+	MCHDEF("VU",   VU,     MT_VU,   0)
+	MCHDEF("BBC",  IEC2,   MT_BBC,  0)
+	MCHDEF("EBU",  IEC2,   MT_EBU,  0)
+	MCHDEF("DIN",  IEC1,   MT_DIN,  0)
+	MCHDEF("NOR",  IEC1,   MT_NOR,  0)
+	MTPDEF("dBTP", MT_NONE, 0)
+	MCHDEF("K12",  KMETER, MT_NONE, 12)
+	MCHDEF("K14",  KMETER, MT_NONE, 14)
+	MCHDEF("K20",  KMETER, MT_NONE, 20)
 	else {
 		free(self);
 		return NULL;
@@ -294,20 +335,21 @@ static void
 run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 
 	if (self->p_refl != *self->reflvl) {
 		self->p_refl = *self->reflvl;
-		self->rlgain = powf (10.0f, 0.05f * (self->p_refl + 18.0));
+		self->rlgain = fast_db_to_coeff (self->p_refl + 18.f);
 	}
 
+	self->mch->process(self->input, n_samples);
+
 	for (uint32_t c = 0; c < self->chn; ++c) {
 
 		float* const input  = self->input[c];
 		float* const output = self->output[c];
 
-		self->mtr[c]->process(input, n_samples);
-
-		self->mval[c] = *self->level[c] = self->rlgain * self->mtr[c]->read();
+		self->mval[c] = *self->level[c] = self->rlgain * self->mch->read(c);
 		if (self->mval[c] != self->mprev[c]) {
 			self->need_expose = true;
 			self->mprev[c] = self->mval[c];
@@ -329,6 +371,7 @@ static void
 kmeter_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 	bool reinit_gui = false;
 
 	/* re-use port 0 to request/notify UI about
@@ -339,9 +382,7 @@ kmeter_run(LV2_Handle instance, uint32_t n_samples)
 		if (fabsf(*self->reflvl) < 3) {
 			self->peak_hold = 0;
 			reinit_gui = true;
-			for (uint32_t c = 0; c < self->chn; ++c) {
-				self->mtr[c]->reset();
-			}
+			self->mch->reset();
 		}
 		/* re-notify UI, until UI acknowledges */
 		if (fabsf(*self->reflvl) == 3) {
@@ -351,13 +392,13 @@ kmeter_run(LV2_Handle instance, uint32_t n_samples)
 		}
 	}
 
+	self->mch->process(self->input, n_samples);
+
 	for (uint32_t c = 0; c < self->chn; ++c) {
 
 		float* const input  = self->input[c];
 		float* const output = self->output[c];
 
-		self->mtr[c]->process(input, n_samples);
-
 		if (input != output) {
 			memcpy(output, input, sizeof(float) * n_samples);
 		}
@@ -375,19 +416,19 @@ kmeter_run(LV2_Handle instance, uint32_t n_samples)
 
 	if (self->chn == 1) {
 		float m, p;
-		static_cast<Kmeterdsp*>(self->mtr[0])->read(m, p);
+		self->mch->read(0, m, p);
 		*self->level[0] = self->rlgain * m;
 		*self->input[1] = self->rlgain * p; // portindex 4
 		if (*self->input[1] > self->peak_hold) self->peak_hold = *self->input[1];
 		*self->output[1] = self->peak_hold; // portindex 5
 	} else if (self->chn == 2) {
 		float m, p;
-		static_cast<Kmeterdsp*>(self->mtr[0])->read(m, p);
+		self->mch->read(0, m, p);
 		*self->level[0] = self->rlgain * m;
 		*self->peak[0] = self->rlgain * p;
 		if (*self->peak[0] > self->peak_hold) self->peak_hold = *self->peak[0];
 
-		static_cast<Kmeterdsp*>(self->mtr[1])->read(m, p);
+		self->mch->read(1, m, p);
 		*self->level[1] = self->rlgain * m;
 		*self->peak[1] = self->rlgain * p;
 		if (*self->peak[1] > self->peak_hold) self->peak_hold = *self->peak[1];
@@ -417,16 +458,14 @@ static void
 cleanup(LV2_Handle instance)
 {
 	LV2meter* self = (LV2meter*)instance;
-	for (uint32_t c = 0; c < self->chn; ++c) {
-		delete self->mtr[c];
-	}
+	delete self->mch;
+	delete self->mtp;
 	FREE_VARPORTS;
 #ifdef DISPLAY_INTERFACE
 	if (self->display) cairo_surface_destroy(self->display);
 	if (self->face) cairo_surface_destroy(self->face);
 	if (self->mpat) cairo_pattern_destroy(self->mpat);
 #endif
-	free (self->mtr);
 	free(instance);
 }
 
@@ -434,6 +473,7 @@ static void
 dbtp_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 	bool reinit_gui = false;
 
 	/* re-use port 0 to request/notify UI about
@@ -444,9 +484,7 @@ dbtp_run(LV2_Handle instance, uint32_t n_samples)
 			reinit_gui = true;
 			self->peak_max[0] = 0;
 			self->peak_max[1] = 0;
-			for (uint32_t c = 0; c < self->chn; ++c) {
-				self->mtr[c]->reset();
-			}
+			self->mtp->reset();
 		}
 		/* re-notify UI, until UI acknowledges */
 		if (fabsf(*self->reflvl) != 3) {
@@ -457,13 +495,13 @@ dbtp_run(LV2_Handle instance, uint32_t n_samples)
 		reinit_gui = true;
 	}
 
+	self->mtp->process(self->input, n_samples);
+
 	for (uint32_t c = 0; c < self->chn; ++c) {
 
 		float* const input  = self->input[c];
 		float* const output = self->output[c];
 
-		self->mtr[c]->process(input, n_samples);
-
 		if (input != output) {
 			memcpy(output, input, sizeof(float) * n_samples);
 		}
@@ -485,17 +523,17 @@ dbtp_run(LV2_Handle instance, uint32_t n_samples)
 
 	if (self->chn == 1) {
 		float m, p;
-		static_cast<TruePeakdsp*>(self->mtr[0])->read(m, p);
+		self->mtp->read(0, m, p);
 		if (self->peak_max[0] < self->rlgain * p) { self->peak_max[0] = self->rlgain * p; }
 		*self->level[0] = self->rlgain * m;
 		*self->input[1] = self->peak_max[0]; // portindex 4
 	} else if (self->chn == 2) {
 		float m, p;
-		static_cast<TruePeakdsp*>(self->mtr[0])->read(m, p);
+		self->mtp->read(0, m, p);
 		if (self->peak_max[0] < self->rlgain * p) { self->peak_max[0] = self->rlgain * p; }
 		*self->level[0] = self->rlgain * m;
 		*self->peak[0] = self->peak_max[0];
-		static_cast<TruePeakdsp*>(self->mtr[1])->read(m, p);
+		self->mtp->read(1, m, p);
 		if (self->peak_max[1] < self->rlgain * p) { self->peak_max[1] = self->rlgain * p; }
 		*self->level[1] = self->rlgain * m;
 		*self->peak[1] = self->peak_max[1];
@@ -503,14 +541,46 @@ dbtp_run(LV2_Handle instance, uint32_t n_samples)
 }
 
 
+static void
+cor_connect_port(LV2_Handle instance, uint32_t port, void* data)
+{
+	LV2meter* self = (LV2meter*)instance;
+
+	switch ((CorPortIndex)port) {
+	case COR_FAST:
+		self->cor_fast = (float*) data;
+		break;
+	case COR_SLOW:
+		self->cor_slow = (float*) data;
+		break;
+	case COR_MIN:
+		self->cor_min = (float*) data;
+		break;
+	case COR_RESET:
+		self->cor_reset = (float*) data;
+		break;
+	default:
+		connect_port(instance, port, data);
+		break;
+	}
+}
+
 static void
 cor_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 
+	if (*self->cor_reset > 0) {
+		self->cor->reset_min();
+	}
 	self->cor->process(self->input[0], self->input[1] , n_samples);
 	self->mval[0] = *self->level[0] = self->cor->read();
 
+	*self->cor_fast = self->cor->read(Stcorrdsp::FAST);
+	*self->cor_slow = self->cor->read(Stcorrdsp::SLOW);
+	*self->cor_min  = self->cor->read_min();
+
 	if (self->mval[0] != self->mprev[0]) {
 		self->need_expose = true;
 		self->mprev[0] = self->mval[0];
@@ -548,20 +618,19 @@ static void
 bbcm_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 
 	if (self->p_refl != *self->reflvl) {
 		self->p_refl = *self->reflvl;
-		self->rlgain = powf (10.0f, 0.05f * (self->p_refl + 18.0));
+		self->rlgain = fast_db_to_coeff (self->p_refl + 18.f);
 	}
 
 	bool s20 = (*(self->peak[0]) > 0.5) ? true : false; // port 7
-	self->bms[1]->set_gain (s20 ? +14 : -6);
+	self->mtx->set_gain (1, s20 ? +14 : -6);
 
-	self->bms[0]->processM(self->input[0], self->input[1], n_samples);
-	self->mval[0] = *self->level[0] = self->rlgain * self->bms[0]->read();
-
-	self->bms[1]->processS(self->input[0], self->input[1], n_samples);
-	self->mval[1] = *self->level[1] = self->rlgain * self->bms[1]->read();
+	self->mtx->process(self->input, n_samples);
+	self->mval[0] = *self->level[0] = self->rlgain * self->mtx->read(0);
+	self->mval[1] = *self->level[1] = self->rlgain * self->mtx->read(1);
 
 	if (self->mval[0] != self->mprev[0] || self->mval[1] != self->mprev[1]) {
 		self->need_expose = true;
@@ -587,8 +656,7 @@ static void
 bbcm_cleanup(LV2_Handle instance)
 {
 	LV2meter* self = (LV2meter*)instance;
-	delete self->bms[0];
-	delete self->bms[1];
+	delete self->mtx;
 	FREE_VARPORTS;
 #ifdef DISPLAY_INTERFACE
 	if (self->display) cairo_surface_destroy(self->display);
@@ -674,6 +742,8 @@ extension_data_kmeter(const char* uri)
 #include "sigdistlv2.c"
 #include "bitmeter.c"
 #include "surmeter.c"
+#include "unimeter.c"
+#include "bandcorr.c"
 
 #define mkdesc(ID, NAME, RUN, EXT) \
 static const LV2_Descriptor descriptor ## ID = { \
@@ -711,7 +781,7 @@ mkdesc(K20S,"K20stereo", kmeter_run, extension_data_kmeter)
 static const LV2_Descriptor descriptorCor = {
 	MTR_URI "COR",
 	instantiate,
-	connect_port,
+	cor_connect_port,
 	NULL,
 	cor_run,
 	NULL,
@@ -782,6 +852,14 @@ lv2_descriptor(uint32_t index)
 	case 35: return &descriptorSUR5;
 	case 36: return &descriptorSUR4;
 	case 37: return &descriptorSUR3;
+	case 38: return &descriptorUNIM;
+	case 39: return &descriptorUNIS;
+	case 40: return &descriptorBCOR1;
+	case 41: return &descriptorBCOR3;
+	case 42: return &descriptorEBUr128_51;
+	case 43: return &descriptorEBUr128_714;
+	case 44: return &descriptorEBUr128_916;
+	case 45: return &descriptorEBUr128_222;
 	default: return NULL;
 	}
 }
@@ -197,6 +197,7 @@ static void
 sdh_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 
 	const uint32_t capacity = self->notify->atom.size;
 	assert(capacity > 920);
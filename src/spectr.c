@@ -51,7 +51,6 @@
 enum filterCoeff {a0 = 0, a1, a2, b0, b1, b2};
 enum filterState {z1 = 0, z2};
 
-#define NODENORMAL (1e-12)
 #define MAXORDER (6)
 
 struct Filter {
@@ -62,7 +61,6 @@ struct Filter {
 struct FilterBank {
 	struct Filter f[MAXORDER];
 	uint32_t filter_stages;
-	bool ac;
 };
 
 static inline double
@@ -78,14 +76,26 @@ proc_one(struct Filter * const f, const double in)
 static inline float
 bandpass_process(struct FilterBank * const fb, const float in)
 {
-	fb->ac = !fb->ac;
-	double out = in + ((fb->ac) ? NODENORMAL : -NODENORMAL);
+	double out = in;
 	for (uint32_t i = 0; i < fb->filter_stages; ++i) {
 		out = proc_one(&fb->f[i], out);
 	}
 	return out;
 }
 
+/* all filter states at or below thr, the bank's output is
+ * negligible until the next non-silent input */
+static inline bool
+bandpass_settled(struct FilterBank * const fb, const double thr)
+{
+	for (uint32_t i = 0; i < fb->filter_stages; ++i) {
+		if (fabs(fb->f[i].z[z1]) > thr || fabs(fb->f[i].z[z2]) > thr) {
+			return false;
+		}
+	}
+	return true;
+}
+
 static void
 bandpass_setup(struct FilterBank *fb,
 		double rate,
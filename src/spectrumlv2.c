@@ -160,6 +160,7 @@ static void
 spectrum_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2spec* self = (LV2spec*)instance;
+	DenormalGuard dg;
 	float* inL = self->input[0];
 	float* inR = self->input[1];
 	bool reinit_gui = false;
@@ -206,27 +207,44 @@ spectrum_run(LV2_Handle instance, uint32_t n_samples)
 
 	const bool stereo = self->nchannels == 2;
 
-	/* .. and go */
-	for (uint32_t j = 0 ; j < n_samples; ++j) {
-		float in;
-		// TODO separate loop implementation for mono+stereo for efficiency
-		if (stereo) {
-			const float L = *(inL++);
-			const float R = *(inR++);
-			in = (L + R) / 2.0f;
-		} else {
-			in = *(inL++);
-		}
-				
+	/* silent input and all filters rung out: the averages decay
+	 * exponentially, peak-hold is unchanged */
+	bool settled = v4_silent (inL, n_samples, silence_floor)
+		&& (!stereo || v4_silent (inR, n_samples, silence_floor));
+	for (int i = 0; settled && i < FILTER_COUNT; ++i) {
+		settled = bandpass_settled (flt[i], silence_floor);
+	}
+
+	if (settled) {
+		const float d = powf (1.f - omega, n_samples);
 		for(int i = 0; i < FILTER_COUNT; ++i) {
-			const float v = bandpass_process(flt[i], in);
-			const float s = v * v;
-			val_f[i] += omega * (s - val_f[i]);
-			if (val_f[i] > max_f[i]) max_f[i] = val_f[i];
+			val_f[i] *= d;
+		}
+	} else {
+		/* .. and go */
+		for (uint32_t j = 0 ; j < n_samples; ++j) {
+			float in;
+			// TODO separate loop implementation for mono+stereo for efficiency
+			if (stereo) {
+				const float L = *(inL++);
+				const float R = *(inR++);
+				in = (L + R) / 2.0f;
+			} else {
+				in = *(inL++);
+			}
+
+			for(int i = 0; i < FILTER_COUNT; ++i) {
+				const float v = bandpass_process(flt[i], in);
+				const float s = v * v;
+				val_f[i] += omega * (s - val_f[i]);
+				if (val_f[i] > max_f[i]) max_f[i] = val_f[i];
+			}
 		}
 	}
 
-	/* copy back variables and assign value */
+	/* copy back variables, levels are converted to dB below */
+	float db_v[FILTER_COUNT];
+	float db_m[FILTER_COUNT];
 	for(int i=0; i < FILTER_COUNT; ++i) {
 		if (!isfinite(val_f[i])) val_f[i] = 0;
 		if (!isfinite(max_f[i])) max_f[i] = 0;
@@ -236,15 +254,21 @@ spectrum_run(LV2_Handle instance, uint32_t n_samples)
 		}
 		self->val_f[i] = val_f[i] + 1e-20f;
 		self->max_f[i] = max_f[i];
+		db_v[i] = 2.f * val_f[i];
+		db_m[i] = 2.f * max_f[i];
+	}
+
+	/* 10 * log10 (2 * power) == 20 * log10 (sqrt (2 * power)) */
+	fast_power_to_db (db_v, db_v, FILTER_COUNT, -100.f, -100.f);
+	fast_power_to_db (db_m, db_m, FILTER_COUNT, -100.f, -100.f);
 
-		const float vs = sqrtf(2. * val_f[i]);
-		const float mx = sqrtf(2. * max_f[i]);
-		*(self->spec[i]) = vs > .00001f ? 20.0 * log10f(vs) : -100.0;
+	for(int i=0; i < FILTER_COUNT; ++i) {
+		*(self->spec[i]) = db_v[i];
 		if (reinit_gui) {
 			/* force parameter change */
 			*(self->maxf[i]) = -500 - (rand() & 0xffff);
 		} else {
-			*(self->maxf[i]) = mx > .00001f ? 20.0 * log10f(mx) : -100.0;
+			*(self->maxf[i]) = db_m[i];
 		}
 	}
 
@@ -49,21 +49,31 @@ sur_instantiate(
 		return NULL;
 	}
 
-	self->mtr = (JmeterDSP **) malloc (self->chn * sizeof (JmeterDSP *));
-	for (uint32_t i = 0; i < self->chn; ++i) {
-		self->mtr[i] = new Kmeterdsp();
-		static_cast<Kmeterdsp *>(self->mtr[i])->init(rate);
+	for (int i = 0; features[i]; ++i) {
+		if (!strcmp (features[i]->URI, LV2_URID__map)) {
+			self->map = (LV2_URID_Map*)features[i]->data;
+		}
+	}
+
+	/* urid:map is optional, it is only needed to publish the
+	 * correlation matrix on the notify port */
+	if (self->map) {
+		map_eburlv2_uris (self->map, &self->uris);
+		lv2_atom_forge_init (&self->forge, self->map);
 	}
 
+	self->mch = new Mchjmeterdsp();
+	self->mch->init (Mchjmeterdsp::KMETER, self->chn, rate);
+
 	self->level  = (float**) calloc (self->chn, sizeof (float*));
 	self->input  = (float**) calloc (self->chn, sizeof (float*));
 	self->output = (float**) calloc (self->chn, sizeof (float*));
 	self->peak   = (float**) calloc (self->chn, sizeof (float*));
 
-	for (uint32_t c = 0; c < 4; ++c) {
-		self->cor4[c] = new Stcorrdsp();
-		self->cor4[c]->init (rate, 2e3f, 0.3f);
-	}
+	self->mcor = new Mchcorrdsp();
+	self->mcor->init (self->chn, rate, 2e3f, 0.3f);
+
+	self->rate = rate;
 	self->rlgain = 1.0;
 	self->p_refl = -9999;
 
@@ -110,32 +120,88 @@ sur_connect_port (LV2_Handle instance, uint32_t port, void* data)
 				break;
 		}
 	}
+	else if (port == 13 + 4 * self->chn) {
+		self->notify = (LV2_Atom_Sequence*) data;
+	}
+	else if (port > 13 + 4 * self->chn && port < 26 + 4 * self->chn) {
+		// fast, slow and minimum correlation
+		int cor = (port - 14 - 4 * self->chn) / 3;
+		switch ((port - 14 - 4 * self->chn) % 3) {
+			case 0:
+				self->surc_f[cor] = (float*) data;
+				break;
+			case 1:
+				self->surc_s[cor] = (float*) data;
+				break;
+			case 2:
+				self->surc_m[cor] = (float*) data;
+				break;
+		}
+	}
+	else if (port == 26 + 4 * self->chn) {
+		self->hold = (float*) data;
+	}
 }
 
 static void
 sur_run(LV2_Handle instance, uint32_t n_samples)
 {
 	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
 	uint32_t cors = self->chn > 3 ? 4 : 3;
 
+	if (*self->hold > 0) {
+		self->mcor->reset_min ();
+	}
+
+	/* all pairs, the selected ones are read from the matrix */
+	self->mcor->process (self->input, n_samples);
+
 	for (uint32_t c = 0; c < cors; ++c) {
 		uint32_t in_a = rintf (*self->surc_a[c]);
 		uint32_t in_b = rintf (*self->surc_b[c]);
 		if (in_a >= self->chn) in_a = self->chn - 1;
 		if (in_b >= self->chn) in_b = self->chn - 1;
-		self->cor4[c]->process (self->input[in_a], self->input[in_b], n_samples);
-		*self->surc_c[c] = self->cor4[c]->read();
+		*self->surc_c[c] = self->mcor->read (in_a, in_b);
+		*self->surc_f[c] = self->mcor->read (in_a, in_b, Mchcorrdsp::FAST);
+		*self->surc_s[c] = self->mcor->read (in_a, in_b, Mchcorrdsp::SLOW);
+		*self->surc_m[c] = self->mcor->read_min (in_a, in_b);
 	}
 
+	if (self->notify && self->map) {
+		const uint32_t capacity = self->notify->atom.size;
+		lv2_atom_forge_set_buffer(&self->forge, (uint8_t*)self->notify, capacity);
+		lv2_atom_forge_sequence_head(&self->forge, &self->frame, 0);
+
+		/* upper triangle of the matrix, row by row:
+		 * (0,1), (0,2) .. (0,n-1), (1,2) .. (n-2,n-1) at ~10fps */
+		const int fps_limit = n_samples * ceil(self->rate / (10.f * n_samples));
+		self->radar_resync += n_samples;
+		if (self->radar_resync >= fps_limit && capacity > 256) {
+			self->radar_resync = self->radar_resync % fps_limit;
+			float cm[Mchcorrdsp::MAXCHAN * (Mchcorrdsp::MAXCHAN - 1) / 2];
+			const int np = self->mcor->read (cm);
+
+			LV2_Atom_Forge_Frame frame;
+			lv2_atom_forge_frame_time(&self->forge, 0);
+			x_forge_object(&self->forge, &frame, 1, self->uris.cor_matrix);
+			lv2_atom_forge_property_head(&self->forge, self->uris.cor_nchan, 0);
+			lv2_atom_forge_int(&self->forge, self->chn);
+			lv2_atom_forge_property_head(&self->forge, self->uris.cor_data, 0);
+			lv2_atom_forge_vector(&self->forge, sizeof(float), self->uris.atom_Float, np, cm);
+			lv2_atom_forge_pop(&self->forge, &frame);
+		}
+	}
+
+	self->mch->process (self->input, n_samples);
+
 	for (uint32_t c = 0; c < self->chn; ++c) {
 		float m, p;
 
 		float* const input  = self->input[c];
 		float* const output = self->output[c];
 
-		self->mtr[c]->process(input, n_samples);
-
-		static_cast<Kmeterdsp*>(self->mtr[c])->read(m, p);
+		self->mch->read (c, m, p);
 
 		*self->level[c] = m;
 		*self->peak[c]  = p;
@@ -150,14 +216,9 @@ static void
 sur_cleanup(LV2_Handle instance)
 {
 	LV2meter* self = (LV2meter*)instance;
-	for (uint32_t c = 0; c < 4; ++c) {
-		delete self->cor4[c];
-	}
-	for (uint32_t c = 0; c < self->chn; ++c) {
-		delete self->mtr[c];
-	}
+	delete self->mcor;
+	delete self->mch;
 	FREE_VARPORTS;
-	free (self->mtr);
 	free(instance);
 }
 
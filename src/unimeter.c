@@ -0,0 +1,118 @@
+/* meter.lv2 -- universal meter
+ *
+ * Copyright (C) 2026 meters.lv2 contributors
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+
+/******************************************************************************
+ * LV2
+ *
+ * ports: [in, out] per channel, followed by the
+ *        Unimeterdsp::NMETER readings of each channel
+ */
+
+static LV2_Handle
+uni_instantiate(
+		const LV2_Descriptor*     descriptor,
+		double                    rate,
+		const char*               bundle_path,
+		const LV2_Feature* const* features)
+{
+	LV2meter* self = (LV2meter*)calloc (1, sizeof (LV2meter));
+	if (!self) return NULL;
+
+	if (       !strcmp (descriptor->URI, MTR_URI "universalmono")) {
+		self->chn = 1;
+	} else if (!strcmp (descriptor->URI, MTR_URI "universalstereo")) {
+		self->chn = 2;
+	} else {
+		free(self);
+		return NULL;
+	}
+
+	self->uni = new Unimeterdsp();
+	self->uni->init (self->chn, rate);
+
+	self->level  = (float**) calloc (self->chn * Unimeterdsp::NMETER, sizeof (float*));
+	self->input  = (float**) calloc (self->chn, sizeof (float*));
+	self->output = (float**) calloc (self->chn, sizeof (float*));
+
+	return (LV2_Handle)self;
+}
+
+static void
+uni_connect_port (LV2_Handle instance, uint32_t port, void* data)
+{
+	LV2meter* self = (LV2meter*)instance;
+	if (port < 2 * self->chn) {
+		if (port & 1) {
+			self->output[port / 2] = (float*) data;
+		} else {
+			self->input[port / 2] = (float*) data;
+		}
+	}
+	else if (port < (2 + Unimeterdsp::NMETER) * self->chn) {
+		self->level[port - 2 * self->chn] = (float*) data;
+	}
+}
+
+static void
+uni_run(LV2_Handle instance, uint32_t n_samples)
+{
+	LV2meter* self = (LV2meter*)instance;
+	DenormalGuard dg;
+
+	self->uni->process (self->input, n_samples);
+
+	for (uint32_t c = 0; c < self->chn; ++c) {
+
+		float* const input  = self->input[c];
+		float* const output = self->output[c];
+
+		for (int m = 0; m < Unimeterdsp::NMETER; ++m) {
+			*self->level[c * Unimeterdsp::NMETER + m] = self->uni->read (m, c);
+		}
+
+		if (input != output) {
+			memcpy(output, input, sizeof(float) * n_samples);
+		}
+	}
+}
+
+static void
+uni_cleanup(LV2_Handle instance)
+{
+	LV2meter* self = (LV2meter*)instance;
+	delete self->uni;
+	FREE_VARPORTS;
+	free(instance);
+}
+
+#define UniDesc(ID, NAME) \
+static const LV2_Descriptor descriptor ## ID = { \
+	MTR_URI NAME, \
+	uni_instantiate, \
+	uni_connect_port, \
+	NULL, \
+	uni_run, \
+	NULL, \
+	uni_cleanup, \
+	extension_data \
+};
+
+UniDesc(UNIM, "universalmono");
+UniDesc(UNIS, "universalstereo");
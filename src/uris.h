@@ -21,10 +21,13 @@
 #define MTR_URIS_H
 
 #include <stdio.h>
+#include <string.h>
 #include "lv2/lv2plug.in/ns/ext/atom/atom.h"
 #include "lv2/lv2plug.in/ns/ext/time/time.h"
 #include "lv2/lv2plug.in/ns/ext/atom/forge.h"
 #include "lv2/lv2plug.in/ns/ext/urid/urid.h"
+#include "lv2/lv2plug.in/ns/ext/options/options.h"
+#include "lv2/lv2plug.in/ns/ext/buf-size/buf-size.h"
 
 #define MTR_URI "http://gareus.org/oss/lv2/meters#"
 
@@ -94,8 +97,13 @@
 #define MTR__bim_den          MTR_URI "bim_den"
 
 #define MTR__truepeak         MTR_URI "truepeak"
+#define MTR__tpfactor         MTR_URI "tpfactor"
 #define MTR__dr14reset        MTR_URI "dr14reset"
 
+#define MTR__cor_matrix       MTR_URI "cor_matrix"
+#define MTR__cor_nchan        MTR_URI "cor_nchan"
+#define MTR__cor_data         MTR_URI "cor_data"
+
 #define MTR__cckey    MTR_URI "controlkey"
 #define MTR__ccval    MTR_URI "controlval"
 #define MTR__control  MTR_URI "control"
@@ -170,8 +178,13 @@ typedef struct {
 	LV2_URID bim_den;
 
 	LV2_URID mtr_truepeak;
+	LV2_URID mtr_tpfactor;
 	LV2_URID mtr_dr14reset;
 
+	LV2_URID cor_matrix;
+	LV2_URID cor_nchan;
+	LV2_URID cor_data;
+
 } EBULV2URIs;
 
 
@@ -256,8 +269,13 @@ map_eburlv2_uris(LV2_URID_Map* map, EBULV2URIs* uris)
 	uris->bim_den             = map->map(map->handle, MTR__bim_den);
 
 	uris->mtr_truepeak        = map->map(map->handle, MTR__truepeak);
+	uris->mtr_tpfactor        = map->map(map->handle, MTR__tpfactor);
 	uris->mtr_dr14reset       = map->map(map->handle, MTR__dr14reset);
 
+	uris->cor_matrix          = map->map(map->handle, MTR__cor_matrix);
+	uris->cor_nchan           = map->map(map->handle, MTR__cor_nchan);
+	uris->cor_data            = map->map(map->handle, MTR__cor_data);
+
 	uris->mtr_cckey          = map->map(map->handle, MTR__cckey);
 	uris->mtr_ccval          = map->map(map->handle, MTR__ccval);
 	uris->mtr_control        = map->map(map->handle, MTR__control);
@@ -309,4 +327,41 @@ get_cc_key_value(
 	return 0;
 }
 
+/* Block length announced by the host through the options feature:
+ * bufsz:maxBlockLength, else bufsz:nominalBlockLength, 0 if unknown.
+ */
+static uint32_t
+lv2_block_length(const LV2_Feature* const* features)
+{
+	LV2_URID_Map* map = NULL;
+	const LV2_Options_Option* opts = NULL;
+
+	for (int i=0; features[i]; ++i) {
+		if (!strcmp(features[i]->URI, LV2_URID__map)) {
+			map = (LV2_URID_Map*)features[i]->data;
+		}
+		else if (!strcmp(features[i]->URI, LV2_OPTIONS__options)) {
+			opts = (const LV2_Options_Option*)features[i]->data;
+		}
+	}
+	if (!map || !opts) {
+		return 0;
+	}
+
+	const LV2_URID atom_Int = map->map(map->handle, LV2_ATOM__Int);
+	const LV2_URID bufsz_max = map->map(map->handle, LV2_BUF_SIZE__maxBlockLength);
+	const LV2_URID bufsz_nom = map->map(map->handle, LV2_BUF_SIZE__nominalBlockLength);
+
+	uint32_t max_len = 0;
+	uint32_t nom_len = 0;
+	for (; opts->key; ++opts) {
+		if (opts->type != atom_Int || !opts->value) continue;
+		const int32_t len = *(const int32_t*)opts->value;
+		if (len <= 0) continue;
+		if (opts->key == bufsz_max) max_len = len;
+		else if (opts->key == bufsz_nom) nom_len = len;
+	}
+	return max_len ? max_len : nom_len;
+}
+
 #endif
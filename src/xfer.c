@@ -44,6 +44,10 @@ typedef struct {
 
 	Stcorrdsp *stcor;
 	float* p_phase;
+	float* p_phase_fast;
+	float* p_phase_slow;
+	float* p_phase_min;
+	float* p_phase_reset;
 
 } Xfer;
 
@@ -57,6 +61,10 @@ typedef enum {
 	SPR_PHASE    = 6,
 	SPR_GAIN     = 7,
 	SPR_RANGE    = 8,
+	SPR_CORFAST  = 13, // phasewheel only
+	SPR_CORSLOW  = 14,
+	SPR_CORMIN   = 15,
+	SPR_CORRESET = 16,
 } XFPortIndex;
 
 
@@ -127,6 +135,18 @@ xfer_connect_port(LV2_Handle handle,
 		case SPR_PHASE:
 			self->p_phase = (float*) data;
 			break;
+		case SPR_CORFAST:
+			self->p_phase_fast = (float*) data;
+			break;
+		case SPR_CORSLOW:
+			self->p_phase_slow = (float*) data;
+			break;
+		case SPR_CORMIN:
+			self->p_phase_min = (float*) data;
+			break;
+		case SPR_CORRESET:
+			self->p_phase_reset = (float*) data;
+			break;
 		default:
 			if (port >= SPR_INPUT0 && port <= SPR_OUTPUT1) {
 				if (port%2) {
@@ -183,6 +203,7 @@ static void
 xfer_run(LV2_Handle handle, uint32_t n_samples)
 {
 	Xfer* self = (Xfer*)handle;
+	DenormalGuard dg;
 	const size_t size = (sizeof(float) * n_samples + 64) * self->n_channels;
 	const uint32_t capacity = self->notify->atom.size;
 	bool capacity_ok = true;
@@ -246,8 +267,14 @@ xfer_run(LV2_Handle handle, uint32_t n_samples)
 	}
 
 	if (self->stcor) {
+		if (*self->p_phase_reset > 0) {
+			self->stcor->reset_min();
+		}
 		self->stcor->process(self->input[0], self->input[1] , n_samples);
 		*self->p_phase = self->stcor->read();
+		*self->p_phase_fast = self->stcor->read(Stcorrdsp::FAST);
+		*self->p_phase_slow = self->stcor->read(Stcorrdsp::SLOW);
+		*self->p_phase_min  = self->stcor->read_min();
 	}
 
 	/* if UI is active, send raw audio data to GUI */
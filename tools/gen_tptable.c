@@ -0,0 +1,55 @@
+/* generate the true-peak oversampling filter tables
+ * (jmeters/truepeak-table.c)
+ *
+ * The coefficients are the same as the ones computed at runtime by
+ * Resampler_table::create (1.0, 24, np) for np = 1, 2, 4.
+ *
+ * gcc -o gen_tptable gen_tptable.c -lm
+ * ./gen_tptable > ../jmeters/truepeak-table.c
+ */
+#include <stdio.h>
+#include <math.h>
+
+#define HLEN 24
+
+static double sinc (double x) {
+	x = fabs (x);
+	if (x < 1e-6) return 1.0;
+	x *= M_PI;
+	return sin (x) / x;
+}
+
+static double wind (double x) {
+	x = fabs (x);
+	if (x >= 1.0) return 0.0f;
+	x *= M_PI;
+	return 0.384 + 0.500 * cos (x) + 0.116 * cos (2 * x);
+}
+
+static void table (const unsigned int np) {
+	const double fr = 1.0;
+	const unsigned int hl = HLEN;
+	float p[HLEN];
+
+	printf ("static const float tp_ctab_%d [%d] = {\n", np, (np + 1) * hl);
+	for (unsigned int j = 0; j <= np; ++j) {
+		double t = (double) j / (double) np;
+		for (unsigned int i = 0; i < hl; ++i) {
+			p[hl - i - 1] = (float)(fr * sinc (t * fr) * wind (t / hl));
+			t += 1;
+		}
+		for (unsigned int i = 0; i < hl; ++i) {
+			printf ("%s%.8e,%s", (i % 4) ? " " : "\t", p[i], (i % 4) == 3 ? "\n" : "");
+		}
+	}
+	printf ("};\n\n");
+}
+
+int main (void) {
+	printf ("/* generated by tools/gen_tptable.c -- do not edit */\n\n");
+	printf ("/* %d taps per phase, (np + 1) phases, as Resampler_table::_ctab */\n", HLEN);
+	table (1);
+	table (2);
+	table (4);
+	return 0;
+}
@@ -0,0 +1,402 @@
+/* check that the meter kernels give the same readings no matter how
+ * the host splits the stream into cycles, and that meters sharing the
+ * same ballistics agree
+ *
+ * Block size: the same signal is processed once in cycles of 4800
+ * frames and once in random cycles of 1..1001 frames that end at the
+ * same 4800 frame boundaries, where both meters are read.
+ *  - VU and IEC type I/II PPM (Mchjmeterdsp, Mtxppmdsp, Unimeterdsp)
+ *    and true-peak (Mchtruepeakdsp) readings are bit-identical.
+ *  - The K-meter rms is the maximum over the values at the end of each
+ *    cycle, and a group of four samples split across cycles is filtered
+ *    sample by sample, so it differs by design. The signal rises
+ *    steadily, so that the last cycle holds the maximum; the K-meter
+ *    rms and peak readings are then equal within 1e-5, relative.
+ *  - Silent input is skipped in closed form, which is exact only to
+ *    rounding, so this signal has no silence.
+ *
+ * Engines, on the same signal in cycles of 4800 frames, bit-identical:
+ *  - Unimeterdsp and Mchjmeterdsp of each type, the K-meter rms, and
+ *    the sample peak against a plain maximum of |x|.
+ *  - Mchjmeterdsp K-meter and Kmeterdsp, rms and peak.
+ *  - Mtxppmdsp with a unit matrix and with M/S coefficients, and
+ *    Mchjmeterdsp of the same IEC type on the input channels, or on
+ *    their sum and difference.
+ *  - Mchcorrdsp and a Stcorrdsp for each pair of channels, all three
+ *    time constants and the minimum.
+ *
+ * Silence: noise alternating with silent stretches, in cycles of 4800
+ * frames that skip the silence in closed form, and in cycles of four
+ * frames that never do. Readings at the 4800 frame boundaries agree
+ * within 1e-4 relative to the largest reading of the meter, the
+ * observed difference is about 1e-6.
+ *
+ * make test_blocksize && ./test_blocksize
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "../jmeters/kmeterdsp.h"
+#include "../jmeters/stcorrdsp.h"
+#include "../jmeters/mchcorrdsp.h"
+#include "../jmeters/mchjmeterdsp.h"
+#include "../jmeters/mtxppmdsp.h"
+#include "../jmeters/mchtruepeakdsp.h"
+#include "../jmeters/unimeterdsp.h"
+
+using namespace LV2M;
+
+#define FSAMP  48000
+#define NCHAN  6
+#define PERIOD 4800
+#define NPER   100
+#define MAXBLK 1001
+#define RANDOM 0
+
+static float sig[NCHAN][PERIOD * NPER];
+static float sil[NCHAN][PERIOD * NPER];
+static int   errors = 0;
+
+/* tol is relative to a, or to ref if given */
+static void compare (const char *name, int per, float a, float b, float tol, float ref = 0) {
+	const bool ok = (tol == 0) ? a == b : fabsf (a - b) <= tol * (ref ? ref : fabsf (a));
+	if (!ok && errors++ < 20) {
+		printf ("%-16s period %3d: %.9g != %.9g\n", name, per, a, b);
+	}
+}
+
+/* Calls f (offset, length) for the cycles of one period, either of
+ * blk frames or, for RANDOM, of random length. */
+template <typename F>
+static void cycles (int per, int blk, F f) {
+	int i = per * PERIOD;
+	const int e = i + PERIOD;
+	while (i < e) {
+		int n = (blk == RANDOM) ? 1 + rand () % MAXBLK : blk;
+		if (n > e - i) n = e - i;
+		f (i, n);
+		i += n;
+	}
+}
+
+static void ptrs (float **p, int i, float (*s)[PERIOD * NPER] = sig) {
+	for (int c = 0; c < NCHAN; c++) p[c] = s[c] + i;
+}
+
+static void test_mchjmeter (int type, int nchan, const char *name) {
+	Mchjmeterdsp a, b;
+	a.init (type, nchan, FSAMP);
+	b.init (type, nchan, FSAMP);
+	const float tol = (type == Mchjmeterdsp::KMETER) ? 1e-5f : 0;
+	for (int per = 0; per < NPER; per++) {
+		cycles (per, PERIOD, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); a.process (p, n); });
+		cycles (per, RANDOM, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); b.process (p, n); });
+		for (int c = 0; c < nchan; c++) {
+			if (type == Mchjmeterdsp::KMETER) {
+				float ra, pa, rb, pb;
+				a.read (c, ra, pa);
+				b.read (c, rb, pb);
+				compare (name, per, ra, rb, tol);
+				compare (name, per, pa, pb, tol);
+			} else {
+				compare (name, per, a.read (c), b.read (c), tol);
+			}
+		}
+	}
+}
+
+static void test_kmeter () {
+	Kmeterdsp a, b;
+	a.init (FSAMP);
+	b.init (FSAMP);
+	for (int per = 0; per < NPER; per++) {
+		cycles (per, PERIOD, [&](int i, int n) { a.process (sig[0] + i, n); });
+		cycles (per, RANDOM, [&](int i, int n) { b.process (sig[0] + i, n); });
+		float ra, pa, rb, pb;
+		a.read (ra, pa);
+		b.read (rb, pb);
+		compare ("Kmeterdsp", per, ra, rb, 1e-5f);
+		compare ("Kmeterdsp", per, pa, pb, 1e-5f);
+	}
+}
+
+static void test_mtxppm (int type, const char *name) {
+	Mtxppmdsp a, b;
+	a.init (type, 2, 2, FSAMP);
+	b.init (type, 2, 2, FSAMP);
+	for (Mtxppmdsp *m = &a; m; m = (m == &a) ? &b : 0) {
+		m->set_coef (0, 0, 1); m->set_coef (0, 1, 1);
+		m->set_coef (1, 0, 1); m->set_coef (1, 1, -1);
+	}
+	for (int per = 0; per < NPER; per++) {
+		cycles (per, PERIOD, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); a.process (p, n); });
+		cycles (per, RANDOM, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); b.process (p, n); });
+		for (int r = 0; r < 2; r++) {
+			compare (name, per, a.read (r), b.read (r), 0);
+		}
+	}
+}
+
+static void test_truepeak (bool max, float fsamp, const char *name) {
+	Mchtruepeakdsp a, b;
+	a.init (NCHAN, fsamp);
+	b.init (NCHAN, fsamp);
+	for (int per = 0; per < NPER; per++) {
+		float *p[NCHAN];
+		if (max) {
+			cycles (per, PERIOD, [&](int i, int n) { ptrs (p, i); a.process_max (p, n); });
+			cycles (per, RANDOM, [&](int i, int n) { ptrs (p, i); b.process_max (p, n); });
+			compare (name, per, a.read_max (), b.read_max (), 0);
+		} else {
+			cycles (per, PERIOD, [&](int i, int n) { ptrs (p, i); a.process (p, n); });
+			cycles (per, RANDOM, [&](int i, int n) { ptrs (p, i); b.process (p, n); });
+			for (int c = 0; c < NCHAN; c++) {
+				float ma, pa, mb, pb;
+				a.read (c, ma, pa);
+				b.read (c, mb, pb);
+				compare (name, per, ma, mb, 0);
+				compare (name, per, pa, pb, 0);
+			}
+		}
+	}
+}
+
+static void test_unimeter (int nchan, const char *name) {
+	Unimeterdsp a, b;
+	a.init (nchan, FSAMP);
+	b.init (nchan, FSAMP);
+	for (int per = 0; per < NPER; per++) {
+		cycles (per, PERIOD, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); a.process (p, n); });
+		cycles (per, RANDOM, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i); b.process (p, n); });
+		for (int m = 0; m < Unimeterdsp::NMETER; m++) {
+			for (int c = 0; c < nchan; c++) {
+				compare (name, per, a.read (m, c), b.read (m, c), m == Unimeterdsp::KRMS ? 1e-5f : 0);
+			}
+		}
+	}
+}
+
+/* Engines */
+
+static void test_uni_vs_mch (int nchan, const char *name) {
+	Unimeterdsp u;
+	Mchjmeterdsp m[4];
+	const int types[4] = { Mchjmeterdsp::VU, Mchjmeterdsp::IEC1, Mchjmeterdsp::IEC2, Mchjmeterdsp::KMETER };
+	const int meters[4] = { Unimeterdsp::VU, Unimeterdsp::IEC1, Unimeterdsp::IEC2, Unimeterdsp::KRMS };
+	u.init (nchan, FSAMP);
+	for (int t = 0; t < 4; t++) m[t].init (types[t], nchan, FSAMP);
+	for (int per = 0; per < NPER; per++) {
+		float *p[NCHAN];
+		ptrs (p, per * PERIOD);
+		u.process (p, PERIOD);
+		for (int t = 0; t < 4; t++) m[t].process (p, PERIOD);
+		for (int c = 0; c < nchan; c++) {
+			float pk = 0;
+			for (int i = 0; i < PERIOD; i++) if (fabsf (p[c][i]) > pk) pk = fabsf (p[c][i]);
+			for (int t = 0; t < 4; t++) {
+				float r, k;
+				if (types[t] == Mchjmeterdsp::KMETER) m[t].read (c, r, k);
+				else r = m[t].read (c);
+				compare (name, per, r, u.read (meters[t], c), 0);
+			}
+			compare (name, per, pk, u.read (Unimeterdsp::PEAK, c), 0);
+		}
+	}
+}
+
+static void test_kmeter_vs_mch (int nchan, const char *name) {
+	Kmeterdsp k[NCHAN];
+	Mchjmeterdsp m;
+	m.init (Mchjmeterdsp::KMETER, nchan, FSAMP);
+	for (int c = 0; c < nchan; c++) k[c].init (FSAMP);
+	for (int per = 0; per < NPER; per++) {
+		float *p[NCHAN];
+		ptrs (p, per * PERIOD);
+		m.process (p, PERIOD);
+		for (int c = 0; c < nchan; c++) {
+			float ra, pa, rb, pb;
+			k[c].process (p[c], PERIOD);
+			k[c].read (ra, pa);
+			m.read (c, rb, pb);
+			compare (name, per, ra, rb, 0);
+			compare (name, per, pa, pb, 0);
+		}
+	}
+}
+
+static void test_mtxppm_vs_mch (int type, bool ms, const char *name) {
+	static float sd[2][PERIOD];
+	Mtxppmdsp a;
+	Mchjmeterdsp b;
+	a.init (type, 2, 2, FSAMP);
+	a.set_coef (0, 0, 1); a.set_coef (0, 1, ms ? 1 : 0);
+	a.set_coef (1, 0, ms ? 1 : 0); a.set_coef (1, 1, ms ? -1 : 1);
+	b.init (type == Mtxppmdsp::IEC1 ? Mchjmeterdsp::IEC1 : Mchjmeterdsp::IEC2, 2, FSAMP);
+	for (int per = 0; per < NPER; per++) {
+		float *p[NCHAN];
+		ptrs (p, per * PERIOD);
+		a.process (p, PERIOD);
+		if (ms) {
+			for (int i = 0; i < PERIOD; i++) {
+				sd[0][i] = p[0][i] + p[1][i];
+				sd[1][i] = p[0][i] - p[1][i];
+			}
+			p[0] = sd[0];
+			p[1] = sd[1];
+		}
+		b.process (p, PERIOD);
+		for (int r = 0; r < 2; r++) {
+			compare (name, per, a.read (r), b.read (r), 0);
+		}
+	}
+}
+
+static void test_corr_vs_st (int nchan, const char *name) {
+	Mchcorrdsp m;
+	Stcorrdsp s[NCHAN][NCHAN];
+	m.init (nchan, FSAMP, 2e3f, 0.3f);
+	for (int a = 0; a < nchan; a++) {
+		for (int b = a + 1; b < nchan; b++) s[a][b].init (FSAMP, 2e3f, 0.3f);
+	}
+	for (int per = 0; per < NPER; per++) {
+		float *p[NCHAN];
+		ptrs (p, per * PERIOD);
+		m.process (p, PERIOD);
+		for (int a = 0; a < nchan; a++) {
+			for (int b = a + 1; b < nchan; b++) {
+				s[a][b].process (p[a], p[b], PERIOD);
+				for (int k = 0; k < Stcorrdsp::NTC; k++) {
+					compare (name, per, s[a][b].read (k), m.read (a, b, k), 0);
+				}
+				compare (name, per, s[a][b].read_min (), m.read_min (a, b), 0);
+			}
+		}
+	}
+}
+
+/* Silence, skipped in closed form or filtered in cycles of four frames */
+
+#define NREAD 8
+
+/* Processes sil with the meter in cycles of blk frames, and stores
+ * up to NREAD readings per period in r. */
+template <typename P>
+static void run_silence (P &proc, int blk, float *r) {
+	for (int per = 0; per < NPER; per++) {
+		cycles (per, blk, [&](int i, int n) { float *p[NCHAN]; ptrs (p, i, sil); proc.run (p, n); });
+		proc.read (r + per * NREAD);
+	}
+}
+
+template <typename P>
+static void test_silence (float tol, const char *name) {
+	static float ra[NPER * NREAD], rb[NPER * NREAD];
+	P a, b;
+	run_silence (a, PERIOD, ra);
+	run_silence (b, 4, rb);
+	float ref = 0;
+	for (int i = 0; i < NPER * NREAD; i++) if (fabsf (rb[i]) > ref) ref = fabsf (rb[i]);
+	for (int i = 0; i < NPER * NREAD; i++) compare (name, i / NREAD, rb[i], ra[i], tol, ref);
+}
+
+/* Wrappers with run () and read () for test_silence. The K-meter is
+ * read before every cycle, so that its rms is the value at the end of
+ * the period and not the maximum over its cycles. Its peak hold counts
+ * cycles and is not compared. */
+
+template <int T, int C>
+struct Mch {
+	Mchjmeterdsp d;
+	Mch () { d.init (T, C, FSAMP); }
+	void run (float **p, int n) {
+		float r, k;
+		if (T == Mchjmeterdsp::KMETER) for (int c = 0; c < C; c++) d.read (c, r, k);
+		d.process (p, n);
+	}
+	void read (float *r) {
+		float k;
+		for (int c = 0; c < C; c++) {
+			if (T == Mchjmeterdsp::KMETER) d.read (c, r[c], k);
+			else r[c] = d.read (c);
+		}
+	}
+};
+
+struct Km {
+	Kmeterdsp d;
+	Km () { d.init (FSAMP); }
+	void run (float **p, int n) { float r, k; d.read (r, k); d.process (p[0], n); }
+	void read (float *r) { float k; d.read (r[0], k); }
+};
+
+struct Cor {
+	Stcorrdsp d;
+	Cor () { d.init (FSAMP, 2e3f, 0.3f); }
+	void run (float **p, int n) { d.process (p[0], p[1], n); }
+	void read (float *r) { for (int k = 0; k < Stcorrdsp::NTC; k++) r[k] = d.read (k); }
+};
+
+struct MchCor {
+	Mchcorrdsp d;
+	MchCor () { d.init (3, FSAMP, 2e3f, 0.3f); }
+	void run (float **p, int n) { d.process (p, n); }
+	void read (float *r) { d.read (r); }
+};
+
+int main () {
+	/* noise, rising by 40 dB over the test */
+	srand (4);
+	for (int c = 0; c < NCHAN; c++) {
+		for (int i = 0; i < PERIOD * NPER; i++) {
+			const float g = 0.01f * powf (100.f, i / (float)(PERIOD * NPER));
+			sig[c][i] = g * (2.f * rand () / (float) RAND_MAX - 1.f) * (1.f + 0.1f * c);
+		}
+	}
+
+	test_mchjmeter (Mchjmeterdsp::VU,     1,     "VU mono");
+	test_mchjmeter (Mchjmeterdsp::VU,     2,     "VU stereo");
+	test_mchjmeter (Mchjmeterdsp::VU,     NCHAN, "VU 6ch");
+	test_mchjmeter (Mchjmeterdsp::IEC1,   2,     "IEC1 stereo");
+	test_mchjmeter (Mchjmeterdsp::IEC1,   NCHAN, "IEC1 6ch");
+	test_mchjmeter (Mchjmeterdsp::IEC2,   2,     "IEC2 stereo");
+	test_mchjmeter (Mchjmeterdsp::IEC2,   NCHAN, "IEC2 6ch");
+	test_mchjmeter (Mchjmeterdsp::KMETER, 2,     "K stereo");
+	test_mchjmeter (Mchjmeterdsp::KMETER, NCHAN, "K 6ch");
+	test_kmeter ();
+	test_mtxppm (Mtxppmdsp::IEC1, "Mtxppm IEC1");
+	test_mtxppm (Mtxppmdsp::IEC2, "Mtxppm IEC2");
+	test_truepeak (false, FSAMP, "TruePeak");
+	test_truepeak (true,  FSAMP, "TruePeak max");
+	test_truepeak (false, 96000, "TruePeak 96k");
+	test_unimeter (2,     "Unimeter stereo");
+	test_unimeter (NCHAN, "Unimeter 6ch");
+
+	test_uni_vs_mch (2,     "Uni/Mch stereo");
+	test_uni_vs_mch (NCHAN, "Uni/Mch 6ch");
+	test_kmeter_vs_mch (1,     "Km/Mch mono");
+	test_kmeter_vs_mch (NCHAN, "Km/Mch 6ch");
+	test_mtxppm_vs_mch (Mtxppmdsp::IEC1, false, "Mtx/Mch IEC1");
+	test_mtxppm_vs_mch (Mtxppmdsp::IEC2, false, "Mtx/Mch IEC2");
+	test_mtxppm_vs_mch (Mtxppmdsp::IEC1, true,  "Mtx/Mch IEC1 MS");
+	test_mtxppm_vs_mch (Mtxppmdsp::IEC2, true,  "Mtx/Mch IEC2 MS");
+	test_corr_vs_st (4, "Mch/Stcorr");
+
+	/* noise for 0.1 s at the start of every 5th period, else silence */
+	for (int c = 0; c < NCHAN; c++) {
+		for (int i = 0; i < PERIOD * NPER; i++) {
+			sil[c][i] = ((i / PERIOD) % 5 || i % PERIOD >= FSAMP / 10) ? 0 : sig[c][i];
+		}
+	}
+	test_silence <Mch<Mchjmeterdsp::VU, 2> >     (1e-4f, "Silence VU");
+	test_silence <Mch<Mchjmeterdsp::VU, NCHAN> > (1e-4f, "Silence VU 6ch");
+	test_silence <Mch<Mchjmeterdsp::IEC1, 2> >   (1e-4f, "Silence IEC1");
+	test_silence <Mch<Mchjmeterdsp::IEC2, NCHAN> >(1e-4f, "Silence IEC2 6ch");
+	test_silence <Mch<Mchjmeterdsp::KMETER, 2> > (1e-4f, "Silence K");
+	test_silence <Km>                            (1e-4f, "Silence Kmeter");
+	test_silence <Cor>                           (1e-4f, "Silence Stcorr");
+	test_silence <MchCor>                        (1e-4f, "Silence Mchcorr");
+
+	printf ("%s, %d mismatches\n", errors ? "FAILED" : "PASSED", errors);
+	return errors ? 1 : 0;
+}
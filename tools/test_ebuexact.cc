@@ -0,0 +1,95 @@
+/* check the exact integrated loudness and loudness range of
+ * Ebu_r128_proc against a brute-force BS.1770 / EBU Tech 3342 reference
+ *
+ * A stereo signal of noise bursts with random levels between 0 and
+ * -30 dBFS is processed in cycles of 4800 frames, so that there is one
+ * momentary value per cycle and one short-term value every fifth cycle.
+ * The reference keeps all of these values and applies the gates and the
+ * 10% / 95% percentiles directly:
+ *  - absolute gate at -70 LUFS,
+ *  - relative gate at -10 LU (integrated) and -20 LU (range) below the
+ *    power mean of the values above the absolute gate,
+ *  - range limits are the values at ranks ceil (0.1 N) and
+ *    floor (0.95 N) + 1 of the N gated short-term values, sorted.
+ *
+ * Expected results: integr_exact() results within 0.001 LU of the
+ * reference, the 0.1 LU histogram results within 0.1 LU.
+ *
+ * make test_ebuexact && ./test_ebuexact
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "../ebumeter/ebu_r128_proc.h"
+
+using namespace LV2M;
+
+#define FSAMP  48000
+#define NFRAME 4800
+#define NCYCLE 6000
+
+static float l[NFRAME], r[NFRAME];
+static int   failures = 0;
+
+static double power_mean (const std::vector<float> &v, float th, int *n) {
+	double p = 0;
+	int k = 0;
+	for (size_t i = 0; i < v.size (); i++) {
+		if (v[i] > -70.f && v[i] > th) { p += pow (10.0, v[i] / 10.0); k++; }
+	}
+	if (n) *n = k;
+	return k ? 10.0 * log10 (p / k) : -200.0;
+}
+
+static void compare (const char *name, double ref, float exact, float coarse) {
+	const bool ok = fabs (exact - ref) < 0.001 && fabs (coarse - ref) < 0.1;
+	if (!ok) ++failures;
+	printf ("%-10s ref %9.4f  exact %9.4f (%+.4f)  0.1 LU %9.4f (%+.4f)  %s\n",
+			name, ref, exact, exact - ref, coarse, coarse - ref, ok ? "ok" : "FAIL");
+}
+
+int main () {
+	Ebu_r128_proc e;
+	std::vector<float> M, S;
+	float g = 0.1f;
+
+	e.init (2, FSAMP);
+	e.integr_exact (true);
+	e.integr_start ();
+
+	srand (5);
+	for (int c = 0; c < NCYCLE; c++) {
+		if (c % 7 == 0) g = powf (10.f, -(rand () % 1500) / 1000.f);
+		for (int i = 0; i < NFRAME; i++) {
+			l[i] = g * (rand () / (float) RAND_MAX - .5f);
+			r[i] = .7f * l[i];
+		}
+		float *p[2] = { l, r };
+		e.process (NFRAME, p);
+		M.push_back (e.loudness_M ());
+		if ((c + 1) % 5 == 0) S.push_back (e.loudness_S ());
+	}
+
+	const double il = power_mean (M, power_mean (M, -70.f, 0) - 10.0, 0);
+
+	std::vector<float> G;
+	const double th = power_mean (S, -70.f, 0) - 20.0;
+	for (size_t i = 0; i < S.size (); i++) {
+		if (S[i] > -70.f && S[i] > th) G.push_back (S[i]);
+	}
+	std::sort (G.begin (), G.end ());
+	const int n = G.size ();
+	const int r0 = (int) ceil (0.1 * n);
+	int r1 = (int) floor (0.95 * n) + 1;
+	if (r1 > n) r1 = n;
+
+	compare ("integrated", il,        e.integrated_exact (), e.integrated ());
+	compare ("range min",  G[r0 - 1], e.range_min_exact (),  e.range_min ());
+	compare ("range max",  G[r1 - 1], e.range_max_exact (),  e.range_max ());
+
+	printf ("%s\n", failures ? "FAILED" : "PASSED");
+	return failures ? 1 : 0;
+}
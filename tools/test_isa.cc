@@ -0,0 +1,113 @@
+/* check that the kernel variants for the detected instruction set give
+ * the same readings as the generic kernels
+ *
+ * The readings of Mchjmeterdsp (all types) and Ebu_r128_proc, both with
+ * more than four channels, are printed as exact hex floats by a child
+ * process that runs with METERS_ISA=generic, and compared with the
+ * readings of this process, which uses the level detected for the CPU
+ * (see cpuisa.h). They must be bit-identical. On a CPU without AVX2
+ * both runs use the generic kernels.
+ *
+ * The Makefile also builds this test at -O0, where the compiler does
+ * not inline the kernels into the variant wrappers.
+ *
+ * make test_isa && ./test_isa
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <string>
+#include <vector>
+
+#include "../jmeters/cpuisa.h"
+#include "../jmeters/mchjmeterdsp.h"
+#include "../ebumeter/ebu_r128_proc.h"
+
+using namespace LV2M;
+
+#define FSAMP  48000
+#define NCHAN  6
+#define NFRAME 1024
+#define NCYCLE 200
+
+static float sig[NCHAN][NFRAME * NCYCLE];
+
+static void readings (std::vector<float> &v) {
+	float *p[NCHAN];
+	const int types[] = { Mchjmeterdsp::VU, Mchjmeterdsp::IEC1, Mchjmeterdsp::IEC2, Mchjmeterdsp::KMETER };
+	for (int t = 0; t < 4; t++) {
+		Mchjmeterdsp m;
+		m.init (types[t], NCHAN, FSAMP);
+		for (int i = 0; i < NCYCLE; i++) {
+			for (int c = 0; c < NCHAN; c++) p[c] = sig[c] + i * NFRAME;
+			m.process (p, NFRAME);
+			for (int c = 0; c < NCHAN; c++) {
+				if (types[t] == Mchjmeterdsp::KMETER) {
+					float r, k;
+					m.read (c, r, k);
+					v.push_back (r);
+					v.push_back (k);
+				} else {
+					v.push_back (m.read (c));
+				}
+			}
+		}
+	}
+
+	Ebu_r128_proc e;
+	e.init (NCHAN, FSAMP);
+	e.integr_start ();
+	for (int i = 0; i < NCYCLE; i++) {
+		for (int c = 0; c < NCHAN; c++) p[c] = sig[c] + i * NFRAME;
+		e.process (NFRAME, p);
+		v.push_back (e.loudness_M ());
+		v.push_back (e.loudness_S ());
+	}
+	v.push_back (e.integrated ());
+	v.push_back (e.range_min ());
+	v.push_back (e.range_max ());
+}
+
+int main (int argc, char **argv) {
+	/* noise with a different level per channel, silence in the middle */
+	srand (7);
+	for (int c = 0; c < NCHAN; c++) {
+		for (int i = 0; i < NFRAME * NCYCLE; i++) {
+			const bool quiet = i > NFRAME * NCYCLE / 2 && i < NFRAME * NCYCLE * 3 / 4;
+			sig[c][i] = quiet ? 0 : (0.1f + 0.1f * c) * (2.f * rand () / (float) RAND_MAX - 1.f);
+		}
+	}
+
+	std::vector<float> v;
+	readings (v);
+
+	if (argc > 1 && !strcmp (argv[1], "-dump")) {
+		for (size_t i = 0; i < v.size (); i++) printf ("%a\n", v[i]);
+		return 0;
+	}
+
+	const std::string cmd = std::string ("METERS_ISA=generic ") + argv[0] + " -dump";
+	FILE *f = popen (cmd.c_str (), "r");
+	if (!f) {
+		perror ("popen");
+		return 1;
+	}
+	size_t n = 0;
+	int errors = 0;
+	char line[64];
+	while (fgets (line, sizeof (line), f)) {
+		const float g = strtof (line, 0);
+		if (n < v.size () && memcmp (&g, &v[n], sizeof (float)) && errors++ < 20) {
+			printf ("reading %4zu: %s %.9g != generic %.9g\n", n, isa_name (isa_level ()), v[n], g);
+		}
+		++n;
+	}
+	if (pclose (f) != 0 || n != v.size ()) {
+		printf ("generic run failed, %zu of %zu readings\n", n, v.size ());
+		++errors;
+	}
+
+	printf ("%s vs generic: %s, %d mismatches\n", isa_name (isa_level ()), errors ? "FAILED" : "PASSED", errors);
+	return errors ? 1 : 0;
+}
@@ -23,6 +23,12 @@
 #include <string.h>
 #include <math.h>
 #include "../zita-resampler/resampler.h"
+#include "../jmeters/simd.h"
+
+#ifdef ISA_X86
+#include <immintrin.h>
+#define RESAMPLER_AVX
+#endif
 
 namespace LV2M {
 
@@ -49,10 +55,66 @@ static unsigned int gcd (unsigned int a, unsigned int b)
 }
 
 
+// FIR kernels for process (). The input window p [n] is interleaved,
+// c [n] holds the coefficients repeated for each channel, so lane l of
+// the accumulators sums channel l % nchan. nchan is 1, 2 or 4.
+
+static void fir_sum (float *t, int w, unsigned int nchan, float *out)
+{
+    for (unsigned int c = 0; c < nchan; c++)
+    {
+	float s = 0;
+	for (int l = c; l < w; l += nchan) s += t [l];
+	*out++ = s;
+    }
+}
+
+
+static void fir_sse (const float *p, const float *c, unsigned int n, unsigned int nchan, float *out)
+{
+    v4sf          a, b;
+    float         t [4];
+    unsigned int  i;
+
+    a = b = v4_set1 (0);
+    for (i = 0; i + 8 <= n; i += 8)
+    {
+	a += v4_load (p + i) * v4_load (c + i);
+	b += v4_load (p + i + 4) * v4_load (c + i + 4);
+    }
+    v4_store (t, a + b);
+    for (; i < n; i++) t [i & 3] += p [i] * c [i];
+    fir_sum (t, 4, nchan, out);
+}
+
+
+#ifdef RESAMPLER_AVX
+__attribute__ ((target ("avx2,fma")))
+static void fir_avx (const float *p, const float *c, unsigned int n, unsigned int nchan, float *out)
+{
+    __m256        a, b;
+    float         t [8];
+    unsigned int  i;
+
+    a = b = _mm256_setzero_ps ();
+    for (i = 0; i + 16 <= n; i += 16)
+    {
+	a = _mm256_fmadd_ps (_mm256_loadu_ps (p + i), _mm256_loadu_ps (c + i), a);
+	b = _mm256_fmadd_ps (_mm256_loadu_ps (p + i + 8), _mm256_loadu_ps (c + i + 8), b);
+    }
+    _mm256_storeu_ps (t, _mm256_add_ps (a, b));
+    for (; i < n; i++) t [i & 7] += p [i] * c [i];
+    fir_sum (t, 8, nchan, out);
+}
+#endif
+
+
 Resampler::Resampler (void) :
     _table (0),
     _nchan (0),
-    _buff  (0)
+    _buff  (0),
+    _ctabx (0),
+    _fir (0)
 {
     reset ();
 }
@@ -80,9 +142,10 @@ int Resampler::setup (unsigned int fs_inp,
                       unsigned int hlen,
                       double       frel)
 {
-    unsigned int       g, h, k, n, s;
+    unsigned int       g, h, i, j, k, n, s;
     double             r;
     float              *B = 0;
+    float              *X = 0;
     Resampler_table    *T = 0;
 
     k = s = 0;
@@ -104,6 +167,19 @@ int Resampler::setup (unsigned int fs_inp,
 	    }
             T = Resampler_table::create (frel, h, n);
 	    B = new float [nchan * (2 * h - 1 + k)];
+	    if (((nchan == 1) || (nchan == 2) || (nchan == 4)) && (n * 2 * h * nchan <= 65536))
+	    {
+		// Coefficients in input order for the whole window,
+		// repeated for each channel, per phase.
+		X = new float [n * 2 * h * nchan];
+		for (i = 0; i < n * 2 * h; i++)
+		{
+		    unsigned int ph = i / (2 * h);
+		    unsigned int t  = i % (2 * h);
+		    float v = (t < h) ? T->_ctab [h * ph + t] : T->_ctab [h * (n - ph) + 2 * h - 1 - t];
+		    for (j = 0; j < nchan; j++) X [i * nchan + j] = v;
+		}
+	    }
 	}
     }
     clear ();
@@ -111,6 +187,11 @@ int Resampler::setup (unsigned int fs_inp,
     {
 	_table = T;
 	_buff  = B;
+	_ctabx = X;
+	_fir = fir_sse;
+#ifdef RESAMPLER_AVX
+	if (isa_level () >= ISA_AVX2) _fir = fir_avx;
+#endif
 	_nchan = nchan;
 	_inmax = k;
 	_pstep = s;
@@ -124,7 +205,9 @@ void Resampler::clear (void)
 {
     Resampler_table::destroy (_table);
     delete[] _buff;
+    delete[] _ctabx;
     _buff  = 0;
+    _ctabx = 0;
     _table = 0;
     _nchan = 0;
     _inmax = 0;
@@ -210,7 +293,12 @@ int Resampler::process (void)
 	{
 	    if (out_data)
 	    {
-		if (nz < 2 * hl)
+		if (nz < 2 * hl && _ctabx)
+		{
+		    _fir (p1, _ctabx + 2 * hl * _nchan * ph, 2 * hl * _nchan, _nchan, out_data);
+		    out_data += _nchan;
+		}
+		else if (nz < 2 * hl)
 		{
 		    float *c1 = _table->_ctab + hl * ph;
 		    float *c2 = _table->_ctab + hl * (np - ph);
@@ -218,14 +306,14 @@ int Resampler::process (void)
 		    {
 			float *q1 = p1 + c;
 			float *q2 = p2 + c;
-			float s = 1e-20f;
+			float s = 0;
 			for (i = 0; i < hl; i++)
 			{
 			    q2 -= _nchan;
 			    s += *q1 * c1 [i] + *q2 * c2 [i];
 			    q1 += _nchan;
 			}
-			*out_data++ = s - 1e-20f;
+			*out_data++ = s;
 		    }
 		}
 		else
@@ -71,6 +71,8 @@ private:
     unsigned int         _phase;
     unsigned int         _pstep;
     float               *_buff;
+    float               *_ctabx;     // coefficients for _fir, see setup ()
+    void               (*_fir) (const float *, const float *, unsigned int, unsigned int, float *);
     void                *_dummy [8];
 };
 